@@ -4,14 +4,65 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../af_baseline.cpp \
+../af_binary.cpp \
+../af_checkpoint.cpp \
+../af_daub.cpp \
+../af_decomp.cpp \
+../af_dwt.cpp \
+../af_engine.cpp \
+../af_follow.cpp \
+../af_index.cpp \
+../af_input.cpp \
+../af_lift.cpp \
+../af_match.cpp \
+../af_parse.cpp \
+../af_ring.cpp \
+../af_scan.cpp \
+../af_uring.cpp \
+../af_wdet.cpp \
 ../alarm_fingerprints_2.cpp \
 ../wavelet_ms.cpp 
 
 OBJS += \
+./af_baseline.o \
+./af_binary.o \
+./af_checkpoint.o \
+./af_daub.o \
+./af_decomp.o \
+./af_dwt.o \
+./af_engine.o \
+./af_follow.o \
+./af_index.o \
+./af_input.o \
+./af_lift.o \
+./af_match.o \
+./af_parse.o \
+./af_ring.o \
+./af_scan.o \
+./af_uring.o \
+./af_wdet.o \
 ./alarm_fingerprints_2.o \
 ./wavelet_ms.o 
 
 CPP_DEPS += \
+./af_baseline.d \
+./af_binary.d \
+./af_checkpoint.d \
+./af_daub.d \
+./af_decomp.d \
+./af_dwt.d \
+./af_engine.d \
+./af_follow.d \
+./af_index.d \
+./af_input.d \
+./af_lift.d \
+./af_match.d \
+./af_parse.d \
+./af_ring.d \
+./af_scan.d \
+./af_uring.d \
+./af_wdet.d \
 ./alarm_fingerprints_2.d \
 ./wavelet_ms.d 
 
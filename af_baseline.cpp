@@ -0,0 +1,131 @@
+/*
+ * af_baseline.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+#include "af_baseline.hpp"
+
+#define AF_MEDIAN_BUCKETS ((AF_MEDIAN_EMAX - AF_MEDIAN_EMIN) * AF_MEDIAN_SUB + 1)
+
+// counts rescaled when the weight of new values exceeds this
+#define AF_MEDIAN_WMAX 1e150
+
+const char *af_baseline_name(int type) {
+	return type == AF_BASELINE_MEDIAN ? "median" : "average";
+}
+
+// bucket of value x >= 0 (x = m * 2^e, m in [0.5, 1)), exponent and leading
+// mantissa bits taken directly from the representation
+static int af_median_bucket(double x) {
+
+	uint64_t u;
+	int e;
+
+	if (!(x > 0))
+		return 0;
+	memcpy(&u, &x, sizeof(u));
+	e = (int) ((u >> 52) & 0x7ff) - 1022;
+	if (e <= AF_MEDIAN_EMIN)
+		return 1;	// also subnormal values
+	if (e > AF_MEDIAN_EMAX)
+		return AF_MEDIAN_BUCKETS - 1;
+	return 1 + (e - 1 - AF_MEDIAN_EMIN) * AF_MEDIAN_SUB
+			+ (int) ((u >> (52 - AF_MEDIAN_SUB_BITS)) & (AF_MEDIAN_SUB - 1));
+}
+
+// lower edges of buckets (upper edge is the lower edge of the next one)
+static double af_median_edges[AF_MEDIAN_BUCKETS + 1];
+
+static void af_median_edges_init() {
+
+	int b;
+
+	if (af_median_edges[AF_MEDIAN_BUCKETS] > 0)
+		return;
+	for (b = 1; b <= AF_MEDIAN_BUCKETS; b++)
+		af_median_edges[b] = ldexp(
+				0.5 + (double) ((b - 1) % AF_MEDIAN_SUB) / (2 * AF_MEDIAN_SUB),
+				(b - 1) / AF_MEDIAN_SUB + AF_MEDIAN_EMIN + 1);
+}
+
+void af_median_init(af_median &m, double initial, int n_amend) {
+
+	af_median_edges_init();
+	m.cnt.assign(AF_MEDIAN_BUCKETS, 0.0);
+	m.med = af_median_bucket(initial);
+	m.cnt[m.med] = m.total = n_amend;
+	m.below = 0;
+	m.w = 1;
+	m.grow = n_amend > 1 ? (double) n_amend / (n_amend - 1) : 0;
+}
+
+double af_median_value(const af_median &m) {
+
+	double lo, frac;
+
+	if (m.med == 0)
+		return 0;
+
+	// linear within the bucket of the median
+	lo = af_median_edges[m.med];
+	frac = (m.total / 2 - m.below) / m.cnt[m.med];
+	if (frac < 0)
+		frac = 0;
+	else if (frac > 1)
+		frac = 1;
+	return AF_MEDIAN_SCALE * (lo + frac * (af_median_edges[m.med + 1] - lo));
+}
+
+double af_median_next(af_median &m, double x) {
+
+	int b = af_median_bucket(x);
+	int i;
+
+	// no smoothing: only the last value counts
+	if (m.grow == 0) {
+		m.cnt.assign(AF_MEDIAN_BUCKETS, 0.0);
+		m.cnt[b] = m.total = 1;
+		m.below = 0;
+		m.med = b;
+		return af_median_value(m);
+	}
+
+	// older counts decay relative to the growing weight of new values
+	m.w *= m.grow;
+	if (m.w > AF_MEDIAN_WMAX) {
+		m.total = m.below = 0;
+		for (i = 0; i < AF_MEDIAN_BUCKETS; i++) {
+			m.cnt[i] /= m.w;
+			m.total += m.cnt[i];
+			if (i < m.med)
+				m.below += m.cnt[i];
+		}
+		m.w = 1;
+	}
+
+	m.cnt[b] += m.w;
+	m.total += m.w;
+	if (b < m.med)
+		m.below += m.w;
+
+	// median bucket: below <= total / 2 < below + cnt[med]
+	while (m.med > 0 && m.below > m.total / 2) {
+		m.med--;
+		m.below -= m.cnt[m.med];
+	}
+	while (m.med < AF_MEDIAN_BUCKETS - 1
+			&& m.below + m.cnt[m.med] <= m.total / 2) {
+		m.below += m.cnt[m.med];
+		m.med++;
+	}
+	if (m.below < 0)
+		m.below = 0;	// rounding of long runs of subtractions
+
+	return af_median_value(m);
+}
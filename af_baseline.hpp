@@ -0,0 +1,61 @@
+/*
+ * af_baseline.hpp
+ *
+ * Baseline (noise level) estimators of the alarm detector. The detector
+ * compares each |diff| against multiplicator * baseline, the baseline is
+ * amended by quiet values only
+ *
+ * AF_BASELINE_EWMA: average |diff| (diffavg) amended by smoothing constant
+ * n_amend, computed inline by the detector (fastest, default)
+ *
+ * AF_BASELINE_MEDIAN: streaming median of |diff| (MAD of differences, their
+ * median being 0) in a fixed-bucket quantile sketch, constant memory:
+ * log-spaced buckets (AF_MEDIAN_SUB per octave), counts decayed with the same
+ * time constant as the average (weight of new values grows instead of decaying
+ * all counts), bucket of the median followed incrementally, O(1) amortized.
+ * Single spikes move the median by one value only instead of inflating the
+ * average for hundreds of values. The median is scaled by AF_MEDIAN_SCALE, so
+ * that it equals average |diff| for normal noise and multiplicator keeps its meaning
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_BASELINE_HPP_
+#define AF_BASELINE_HPP_
+
+#include <vector>
+
+#define AF_BASELINE_EWMA 0
+#define AF_BASELINE_MEDIAN 1
+
+// buckets per octave, octaves covered (values outside clamped to end buckets)
+#define AF_MEDIAN_SUB_BITS 3
+#define AF_MEDIAN_SUB (1 << AF_MEDIAN_SUB_BITS)
+#define AF_MEDIAN_EMIN -60
+#define AF_MEDIAN_EMAX 68
+
+// mean / median of |x| for normal distribution, sqrt(2/pi) / 0.6744897...
+#define AF_MEDIAN_SCALE 1.1829372
+
+struct af_median {
+	std::vector<double> cnt;	// decayed counts of buckets (bucket 0: zero values)
+	double total;				// sum of counts
+	double below;				// sum of counts of buckets below med
+	double w;					// weight of the next value
+	double grow;				// 1 / decay of one value
+	int med;					// bucket of the median
+};
+
+// name of estimator
+const char *af_baseline_name(int type);
+
+// sketch starting with initial value of weight n_amend (as the average)
+void af_median_init(af_median &m, double initial, int n_amend);
+
+// adds quiet value x >= 0, returns new baseline (scaled median)
+double af_median_next(af_median &m, double x);
+
+// current baseline (scaled median)
+double af_median_value(const af_median &m);
+
+#endif /* AF_BASELINE_HPP_ */
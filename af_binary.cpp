@@ -0,0 +1,243 @@
+/*
+ * af_binary.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+#include <cmath>
+
+#include "af_binary.hpp"
+
+// size of values of one block, padded to 8 bytes
+static size_t af_bin_values_size(uint32_t count, uint32_t type,
+		uint32_t columns) {
+	size_t n = (size_t) count * columns
+			* (type == AF_BIN_INT32 ? sizeof(int32_t) : sizeof(double));
+	return (n + 7) & ~(size_t) 7;
+}
+
+// true if data (of size n) starts with binary format header
+bool af_bin_is_binary(const char *data, size_t n) {
+	return n >= sizeof(af_bin_header) && memcmp(data, AF_BIN_MAGIC, 4) == 0;
+}
+
+// opens reader on data of size n, returns 0 if ok
+int af_bin_open(af_bin_reader &r, const char *data, size_t n) {
+
+	if (!af_bin_is_binary(data, n))
+		return 1;
+
+	memcpy(&r.h, data, sizeof(af_bin_header));
+	if (r.h.version != AF_BIN_VERSION || r.h.columns < 1)
+		return 1;
+
+	r.p = data + sizeof(af_bin_header);
+	r.e = data + n;
+	r.ts = r.vals = NULL;
+	r.count = r.type = r.i = 0;
+
+	return 0;
+}
+
+// moves to next non empty block if current one is read, returns false at end of data
+static bool af_bin_block(af_bin_reader &r) {
+
+	uint32_t hdr[2];
+
+	while (r.i >= r.count) {
+		if (r.e - r.p < (ptrdiff_t) sizeof(hdr))
+			return false;
+		memcpy(hdr, r.p, sizeof(hdr));
+		if (hdr[1] != AF_BIN_DOUBLE && hdr[1] != AF_BIN_INT32)
+			return false;
+		if ((size_t) (r.e - r.p)
+				< sizeof(hdr) + (size_t) hdr[0] * sizeof(long long)
+						+ af_bin_values_size(hdr[0], hdr[1], r.h.columns))
+			return false;	// truncated file
+
+		r.count = hdr[0];
+		r.type = hdr[1];
+		r.i = 0;
+		r.ts = r.p + sizeof(hdr);
+		r.vals = r.ts + (size_t) r.count * sizeof(long long);
+		r.p = r.vals + af_bin_values_size(r.count, r.type, r.h.columns);
+	}
+
+	return true;
+}
+
+// next record: timestamp and values of all columns (v[columns])
+bool af_bin_next(af_bin_reader &r, long long &ts, double *v) {
+
+	int32_t iv;
+	uint32_t j;
+
+	if (!af_bin_block(r))
+		return false;
+
+	memcpy(&ts, r.ts + (size_t) r.i * sizeof(long long), sizeof(long long));
+
+	for (j = 0; j < r.h.columns; j++) {
+		if (r.type == AF_BIN_INT32) {
+			memcpy(&iv, r.vals + ((size_t) j * r.count + r.i) * sizeof(int32_t),
+					sizeof(int32_t));
+			v[j] = iv;
+		} else
+			memcpy(&v[j],
+					r.vals + ((size_t) j * r.count + r.i) * sizeof(double),
+					sizeof(double));
+	}
+
+	r.i++;
+
+	return true;
+}
+
+uint32_t af_bin_read(af_bin_reader &r, long long *ts, double *v, uint32_t n) {
+
+	uint32_t k = 0, m, j;
+	int32_t iv;
+
+	while (k < n && af_bin_block(r)) {
+		m = r.count - r.i;
+		if (m > n - k)
+			m = n - k;
+		memcpy(ts + k, r.ts + (size_t) r.i * sizeof(long long),
+				(size_t) m * sizeof(long long));
+		if (r.type == AF_BIN_INT32)
+			for (j = 0; j < m; j++) {
+				memcpy(&iv, r.vals + (size_t) (r.i + j) * sizeof(int32_t),
+						sizeof(int32_t));
+				v[k + j] = iv;
+			}
+		else
+			memcpy(v + k, r.vals + (size_t) r.i * sizeof(double),
+					(size_t) m * sizeof(double));
+		r.i += m;
+		k += m;
+	}
+
+	return k;
+}
+
+// writes buffered records as one block
+static int af_bin_flush(af_bin_writer &w) {
+
+	uint32_t hdr[2];
+	uint32_t count = w.ts.size();
+	uint32_t j, i;
+	size_t padding;
+	int32_t iv;
+	double v;
+	static const char zeros[8] = { 0 };
+
+	if (count == 0)
+		return 0;
+
+	// values stored as int32 if all of them are such integers
+	hdr[0] = count;
+	hdr[1] = AF_BIN_INT32;
+	for (j = 0; j < w.h.columns && hdr[1] == AF_BIN_INT32; j++)
+		for (i = 0; i < count; i++) {
+			v = w.vals[(size_t) j * w.h.block_len + i];
+			if (!(v >= -2147483648.0 && v <= 2147483647.0
+					&& v == (double) (int32_t) v && !(v == 0 && std::signbit(v)))) {
+				hdr[1] = AF_BIN_DOUBLE;
+				break;
+			}
+		}
+
+	if (fwrite(hdr, sizeof(hdr), 1, w.f) != 1
+			|| fwrite(&w.ts[0], sizeof(long long), count, w.f) != count)
+		return 1;
+
+	for (j = 0; j < w.h.columns; j++) {
+		if (hdr[1] == AF_BIN_INT32) {
+			for (i = 0; i < count; i++) {
+				iv = (int32_t) w.vals[(size_t) j * w.h.block_len + i];
+				if (fwrite(&iv, sizeof(iv), 1, w.f) != 1)
+					return 1;
+			}
+		} else if (fwrite(&w.vals[(size_t) j * w.h.block_len], sizeof(double),
+				count, w.f) != count)
+			return 1;
+	}
+
+	padding = af_bin_values_size(count, hdr[1], w.h.columns)
+			- (size_t) count * w.h.columns
+					* (hdr[1] == AF_BIN_INT32 ? sizeof(int32_t) : sizeof(double));
+	if (padding && fwrite(zeros, 1, padding, w.f) != padding)
+		return 1;
+
+	w.h.records += count;
+	w.ts.clear();
+
+	return 0;
+}
+
+// creates binary file fn for given number of columns, returns 0 if ok
+int af_bin_create(af_bin_writer &w, const std::string &fn, int columns,
+		unsigned lead_lines) {
+
+	memset(&w.h, 0, sizeof(w.h));
+	memcpy(w.h.magic, AF_BIN_MAGIC, 4);
+	w.h.version = AF_BIN_VERSION;
+	w.h.columns = columns;
+	w.h.block_len = AF_BIN_BLOCK_LEN;
+	w.h.records = 0;
+	w.h.lead_lines = lead_lines;
+
+	w.ts.clear();
+	w.ts.reserve(w.h.block_len);
+	w.vals.assign((size_t) w.h.block_len * columns, 0.0);
+
+	w.f = fopen(fn.c_str(), "wb");
+	if (w.f == NULL)
+		return 1;
+
+	// header is rewritten with final counts at close
+	if (fwrite(&w.h, sizeof(w.h), 1, w.f) != 1) {
+		fclose(w.f);
+		w.f = NULL;
+		return 1;
+	}
+
+	return 0;
+}
+
+// appends record (v[columns])
+int af_bin_append(af_bin_writer &w, long long ts, const double *v) {
+
+	uint32_t i = w.ts.size();
+	uint32_t j;
+
+	for (j = 0; j < w.h.columns; j++)
+		w.vals[(size_t) j * w.h.block_len + i] = v[j];
+	w.ts.push_back(ts);
+
+	if (w.ts.size() >= w.h.block_len)
+		return af_bin_flush(w);
+
+	return 0;
+}
+
+// flushes, writes final header and closes file, returns 0 if ok
+int af_bin_close(af_bin_writer &w) {
+
+	int err;
+
+	if (w.f == NULL)
+		return 1;
+
+	err = af_bin_flush(w);
+	if (!err)
+		err = fseek(w.f, 0, SEEK_SET) != 0
+				|| fwrite(&w.h, sizeof(w.h), 1, w.f) != 1;
+	if (fclose(w.f) != 0)
+		err = 1;
+	w.f = NULL;
+
+	return err;
+}
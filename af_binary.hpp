@@ -0,0 +1,85 @@
+/*
+ * af_binary.hpp
+ *
+ * Binary columnar measurement format
+ *
+ * File layout (little endian, as written by the converting run -C):
+ *   header (af_bin_header, 32 bytes)
+ *   blocks, each:
+ *     uint32 count			number of records in block (<= block_len)
+ *     uint32 type			value type of the block (AF_BIN_DOUBLE or AF_BIN_INT32)
+ *     int64  ts[count]		timestamps, microseconds since epoch
+ *     values[columns][count]	values, column after column, padded to 8 bytes
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_BINARY_HPP_
+#define AF_BINARY_HPP_
+
+#include <cstdio>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define AF_BIN_MAGIC "AFMB"
+#define AF_BIN_VERSION 1
+#define AF_BIN_BLOCK_LEN 4096
+
+// value types of blocks
+#define AF_BIN_DOUBLE 0
+#define AF_BIN_INT32 1
+
+struct af_bin_header {
+	char magic[4];			// AF_BIN_MAGIC
+	uint32_t version;		// AF_BIN_VERSION
+	uint32_t columns;		// number of value columns
+	uint32_t block_len;		// maximum number of records in block
+	uint64_t records;		// total number of records
+	uint32_t lead_lines;	// text lines preceding the first record in source (header)
+	uint32_t reserved;
+};
+
+// reader of mapped binary file
+struct af_bin_reader {
+	af_bin_header h;
+	const char *p;		// next block
+	const char *e;		// end of data
+	const char *ts;		// timestamps of current block
+	const char *vals;	// values of current block
+	uint32_t count;		// records in current block
+	uint32_t type;		// value type of current block
+	uint32_t i;			// next record in current block
+};
+
+// writer of binary file
+struct af_bin_writer {
+	FILE *f;
+	af_bin_header h;
+	std::vector<long long> ts;
+	std::vector<double> vals;	// column after column, block_len each
+};
+
+// true if data (of size n) starts with binary format header
+bool af_bin_is_binary(const char *data, size_t n);
+
+// opens reader on data of size n, returns 0 if ok
+int af_bin_open(af_bin_reader &r, const char *data, size_t n);
+
+// next record: timestamp and values of all columns (v[columns])
+bool af_bin_next(af_bin_reader &r, long long &ts, double *v);
+
+// up to n next records of single column file to ts[], v[] (copied block by block),
+// returns number of records read
+uint32_t af_bin_read(af_bin_reader &r, long long *ts, double *v, uint32_t n);
+
+// creates binary file fn for given number of columns, returns 0 if ok
+int af_bin_create(af_bin_writer &w, const std::string &fn, int columns,
+		unsigned lead_lines);
+// appends record (v[columns])
+int af_bin_append(af_bin_writer &w, long long ts, const double *v);
+// flushes, writes final header and closes file, returns 0 if ok
+int af_bin_close(af_bin_writer &w);
+
+#endif /* AF_BINARY_HPP_ */
@@ -0,0 +1,119 @@
+/*
+ * af_checkpoint.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+
+#include "af_checkpoint.hpp"
+
+void af_ckpt_header_init(af_ckpt_header &h, int columns, int fingerprint_n,
+		int max_windows, int detector, int baseline, int wavelet_function) {
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, AF_CKPT_MAGIC, 4);
+	h.version = AF_CKPT_VERSION;
+	h.columns = columns;
+	h.fingerprint_n = fingerprint_n;
+	h.max_windows = max_windows;
+	h.detector = detector;
+	h.baseline = baseline;
+	h.wavelet_function = wavelet_function;
+}
+
+int af_ckpt_create(af_ckpt &c, const std::string &fn, const af_ckpt_header &h) {
+
+	c.fn = fn;
+	c.save = true;
+	c.f = fopen((fn + ".tmp").c_str(), "wb");
+	if (c.f == NULL)
+		return 1;
+	c.ok = fwrite(&h, sizeof(h), 1, c.f) == 1;
+	return !c.ok;
+}
+
+int af_ckpt_commit(af_ckpt &c) {
+
+	if (fflush(c.f) != 0)
+		c.ok = false;
+	if (fclose(c.f) != 0)
+		c.ok = false;
+	c.f = NULL;
+	if (!c.ok || rename((c.fn + ".tmp").c_str(), c.fn.c_str()) != 0) {
+		remove((c.fn + ".tmp").c_str());
+		return 1;
+	}
+	return 0;
+}
+
+int af_ckpt_open(af_ckpt &c, const std::string &fn, af_ckpt_header &h) {
+
+	c.fn = fn;
+	c.save = false;
+	c.f = fopen(fn.c_str(), "rb");
+	if (c.f == NULL)
+		return 1;
+	c.ok = fread(&h, sizeof(h), 1, c.f) == 1
+			&& memcmp(h.magic, AF_CKPT_MAGIC, 4) == 0
+			&& h.version == AF_CKPT_VERSION;
+	if (!c.ok) {
+		fclose(c.f);
+		c.f = NULL;
+		return 2;
+	}
+	return 0;
+}
+
+int af_ckpt_close(af_ckpt &c) {
+
+	if (c.f == NULL)
+		return 1;
+	if (fgetc(c.f) != EOF)
+		c.ok = false;	// not all of the file read
+	fclose(c.f);
+	c.f = NULL;
+	return !c.ok;
+}
+
+void af_ckpt_io(af_ckpt &c, void *p, size_t n) {
+
+	if (!c.ok)
+		return;
+	if (c.save)
+		c.ok = fwrite(p, n, 1, c.f) == 1;
+	else
+		c.ok = fread(p, n, 1, c.f) == 1;
+}
+
+void af_ckpt_io_vec(af_ckpt &c, std::vector<double> &v, size_t max) {
+
+	uint32_t n = v.size();
+
+	af_ckpt_io(c, &n, sizeof(n));
+	if (!c.ok)
+		return;
+	if (!c.save) {
+		if (n > max) {
+			c.ok = false;
+			return;
+		}
+		v.resize(n);
+	}
+	if (n)
+		af_ckpt_io(c, &v[0], (size_t) n * sizeof(double));
+}
+
+uint64_t af_ckpt_hash(const std::vector<std::string> &s, size_t n) {
+
+	uint64_t h = 14695981039346656037ULL;
+	size_t i, j;
+
+	for (i = 0; i < n && i < s.size(); i++)
+		for (j = 0; j <= s[i].size(); j++) {
+			// terminating zero separates the strings
+			h ^= (unsigned char) (j < s[i].size() ? s[i][j] : 0);
+			h *= 1099511628211ULL;
+		}
+	return h;
+}
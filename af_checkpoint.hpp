@@ -0,0 +1,70 @@
+/*
+ * af_checkpoint.hpp
+ *
+ * Checkpoint file of the detector state (warm restart by --resume)
+ *
+ * File layout (native byte order, written by the same build):
+ *   header (af_ckpt_header, 32 bytes), parameters the state depends on
+ *   fields of the state in the order given by the program, vectors as
+ *   uint32 length followed by items
+ *
+ * Written to <file>.tmp and renamed, so the file is always complete
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_CHECKPOINT_HPP_
+#define AF_CHECKPOINT_HPP_
+
+#include <cstdio>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define AF_CKPT_MAGIC "AFCP"
+#define AF_CKPT_VERSION 1
+
+struct af_ckpt_header {
+	char magic[4];			// AF_CKPT_MAGIC
+	uint32_t version;		// AF_CKPT_VERSION
+	uint32_t columns;
+	uint32_t fingerprint_n;
+	uint32_t max_windows;
+	uint32_t detector;
+	uint32_t baseline;
+	uint32_t wavelet_function;
+};
+
+// checkpoint being written (save) or read
+struct af_ckpt {
+	FILE *f;
+	std::string fn;
+	bool save;
+	bool ok;				// false after any write/read error
+};
+
+// starts writing of checkpoint fn (to fn.tmp), returns 0 if ok
+int af_ckpt_create(af_ckpt &c, const std::string &fn, const af_ckpt_header &h);
+// finishes writing, renames fn.tmp to fn, returns 0 if ok
+int af_ckpt_commit(af_ckpt &c);
+
+// opens checkpoint fn for reading, header to h, returns 0 if ok
+// (1 if file does not exist, 2 if it is not a checkpoint of this version)
+int af_ckpt_open(af_ckpt &c, const std::string &fn, af_ckpt_header &h);
+// ends reading, returns 0 if all fields were read and the file ends
+int af_ckpt_close(af_ckpt &c);
+
+// header of current parameters
+void af_ckpt_header_init(af_ckpt_header &h, int columns, int fingerprint_n,
+		int max_windows, int detector, int baseline, int wavelet_function);
+
+// field of n bytes written (save) or read, the same call used for both
+void af_ckpt_io(af_ckpt &c, void *p, size_t n);
+// vector written or read (read: at most max items, else error)
+void af_ckpt_io_vec(af_ckpt &c, std::vector<double> &v, size_t max);
+
+// hash of strings (FNV-1a), e.g. names of loaded bank patterns
+uint64_t af_ckpt_hash(const std::vector<std::string> &s, size_t n);
+
+#endif /* AF_CHECKPOINT_HPP_ */
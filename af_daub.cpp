@@ -0,0 +1,429 @@
+/*
+ * af_daub.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+// products and sums of the vector versions rounded one by one as in the
+// scalar reference (AVX-512 targets would fuse them otherwise)
+#pragma GCC optimize ("fp-contract=off")
+
+#include <cstddef>
+
+#include "af_daub.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AF_DAUB_X86
+#endif
+
+// definitions of the constexpr tables (their addresses are used)
+constexpr double af_daub_coef<2>::c[2];
+constexpr double af_daub_coef<4>::c[4];
+constexpr double af_daub_coef<6>::c[6];
+constexpr double af_daub_coef<8>::c[8];
+constexpr double af_daub_coef<10>::c[10];
+constexpr double af_daub_coef<12>::c[12];
+constexpr double af_daub_coef<14>::c[14];
+constexpr double af_daub_coef<16>::c[16];
+constexpr double af_daub_coef<18>::c[18];
+constexpr double af_daub_coef<20>::c[20];
+
+#ifdef AF_DAUB_X86
+
+// the pairs not computed by vectors (the last (P - 2) / 2 of the level and
+// those not filling a vector), at most
+#define AF_DAUB_REST 32
+
+// pairs i0 .. h - 1 of level with m values s (interleaved) by the scalar kernel
+// to ta, tb; computed before the vectors overwrite z, which may hold s
+template<int P>
+static inline void af_daub_rest(const double *s, int m, int ni, int i0,
+		double *ta, double *tb) {
+
+	int i;
+
+	for (i = i0; i < ni; i++)
+		af_daub_kernel<P, false>::pair(s, 2 * i, m, ta[i - i0], tb[i - i0]);
+	for (; i < m / 2; i++)
+		af_daub_kernel<P, true>::pair(s, 2 * i, m, ta[i - i0], tb[i - i0]);
+}
+
+// even values of s (m values) to e, odd to o
+__attribute__((target("avx2")))
+static void af_daub_split_avx2(const double *s, int m, double *e, double *o) {
+
+	__m256d v0, v1;
+	int i;
+
+	for (i = 0; i + 8 <= m; i += 8) {
+		v0 = _mm256_loadu_pd(s + i);
+		v1 = _mm256_loadu_pd(s + i + 4);
+		_mm256_storeu_pd(e + i / 2,
+				_mm256_permute4x64_pd(_mm256_unpacklo_pd(v0, v1), 0xd8));
+		_mm256_storeu_pd(o + i / 2,
+				_mm256_permute4x64_pd(_mm256_unpackhi_pd(v0, v1), 0xd8));
+	}
+	for (; i < m; i += 2) {
+		e[i / 2] = s[i];
+		o[i / 2] = s[i + 1];
+	}
+}
+
+// taps K, K + 1 of 4 pairs, y[2 * i + K] being e[i + K / 2] and y[2 * i + K + 1]
+// o[i + K / 2], in the order of af_daub_taps (daub4 without the leading zero)
+template<int P, int K>
+__attribute__((target("avx2")))
+static inline void af_daub_tap_avx2(const double *e, const double *o,
+		__m256d &a, __m256d &b) {
+
+	const double *c = af_daub_coef<P>::c;
+	__m256d ve = _mm256_loadu_pd(e + K / 2);
+	__m256d vo = _mm256_loadu_pd(o + K / 2);
+
+	if (P == 4 && K == 0) {
+		a = _mm256_mul_pd(_mm256_set1_pd(c[0]), ve);
+		b = _mm256_mul_pd(_mm256_set1_pd(c[3]), ve);
+	} else {
+		a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_set1_pd(c[K]), ve));
+		b = _mm256_add_pd(b, _mm256_mul_pd(_mm256_set1_pd(c[P - 1 - K]), ve));
+	}
+	a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_set1_pd(c[K + 1]), vo));
+	b = _mm256_sub_pd(b, _mm256_mul_pd(_mm256_set1_pd(c[P - 2 - K]), vo));
+}
+
+// taps K, K + 2, ... of NV vectors of pairs, independent sums interleaved
+template<int P, int K, int NV> struct af_daub_taps_avx2 {
+	__attribute__((target("avx2")))
+	static inline void add(const double *e, const double *o, __m256d *a,
+			__m256d *b) {
+
+		int v;
+
+		for (v = 0; v < NV; v++)
+			af_daub_tap_avx2<P, K>(e + 4 * v, o + 4 * v, a[v], b[v]);
+		af_daub_taps_avx2<P, K + 2, NV>::add(e, o, a, b);
+	}
+};
+
+template<int P, int NV> struct af_daub_taps_avx2<P, P, NV> {
+	__attribute__((target("avx2")))
+	static inline void add(const double *, const double *, __m256d *,
+			__m256d *) {
+	}
+};
+
+// 4 * NV pairs from e, o to approximations za and details zb
+template<int P, int NV> struct af_daub_pairs_avx2 {
+	__attribute__((target("avx2")))
+	static inline void run(const double *e, const double *o, double *za,
+			double *zb) {
+
+		__m256d a[NV], b[NV];
+		int v;
+
+		for (v = 0; v < NV; v++)
+			a[v] = b[v] = _mm256_setzero_pd();
+		af_daub_taps_avx2<P, 0, NV>::add(e, o, a, b);
+		for (v = 0; v < NV; v++) {
+			_mm256_storeu_pd(za + 4 * v, a[v]);
+			_mm256_storeu_pd(zb + 4 * v, b[v]);
+		}
+	}
+};
+
+template<int NV> struct af_daub_pairs_avx2<2, NV> {
+	__attribute__((target("avx2")))
+	static inline void run(const double *e, const double *o, double *za,
+			double *zb) {
+
+		const __m256d c0 = _mm256_set1_pd(af_daub_coef<2>::c[0]);
+		const __m256d c1 = _mm256_set1_pd(af_daub_coef<2>::c[1]);
+		__m256d ve, vo;
+		int v;
+
+		for (v = 0; v < NV; v++) {
+			ve = _mm256_loadu_pd(e + 4 * v);
+			vo = _mm256_loadu_pd(o + 4 * v);
+			_mm256_storeu_pd(za + 4 * v, _mm256_mul_pd(c0, _mm256_add_pd(ve, vo)));
+			_mm256_storeu_pd(zb + 4 * v, _mm256_mul_pd(c1, _mm256_sub_pd(ve, vo)));
+		}
+	}
+};
+
+// values of each level kept split to even (y[0 .. m / 2)) and odd values
+// (y[m / 2 .. m)), so that the taps are plain loads; x must not be y
+template<int P>
+__attribute__((target("avx2")))
+static void af_daub_transform_avx2(int n, const double x[], double y[],
+		double z[]) {
+
+	const int minm = P == 2 ? 2 : 4;
+	const double *s = x;
+	double ta[AF_DAUB_REST], tb[AF_DAUB_REST];
+	int i, i0, m, h, ni;
+
+	if (x == y || n < minm) {
+		af_daub_transform<P>(n, x, y, z);
+		return;
+	}
+
+	af_daub_split_avx2(x, n, y, y + n / 2);
+	for (m = n; m >= minm; m /= 2) {
+		h = m / 2;
+		ni = af_daub_interior<P>(m);
+		i0 = ni - ni % 4;
+		af_daub_rest<P>(s, m, ni, i0, ta, tb);
+		for (i = 0; i + 8 <= i0; i += 8)
+			af_daub_pairs_avx2<P, 2>::run(y + i, y + h + i, z + i, z + h + i);
+		if (i < i0)
+			af_daub_pairs_avx2<P, 1>::run(y + i, y + h + i, z + i, z + h + i);
+		for (i = i0; i < h; i++) {
+			z[i] = ta[i - i0];
+			z[h + i] = tb[i - i0];
+		}
+
+		// details final, approximations split as values of the next level
+		for (i = h; i < m; i++)
+			y[i] = z[i];
+		if (h >= minm)
+			af_daub_split_avx2(z, h, y, y + h / 2);
+		else
+			for (i = 0; i < h; i++)
+				y[i] = z[i];
+		s = z;
+	}
+}
+
+// as af_daub_split_avx2, 16 values per step
+__attribute__((target("avx512f")))
+static void af_daub_split_avx512(const double *s, int m, double *e, double *o) {
+
+	const __m512i ie = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+	const __m512i io = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+	__m512d v0, v1;
+	int i;
+
+	for (i = 0; i + 16 <= m; i += 16) {
+		v0 = _mm512_loadu_pd(s + i);
+		v1 = _mm512_loadu_pd(s + i + 8);
+		_mm512_storeu_pd(e + i / 2, _mm512_permutex2var_pd(v0, ie, v1));
+		_mm512_storeu_pd(o + i / 2, _mm512_permutex2var_pd(v0, io, v1));
+	}
+	for (; i < m; i += 2) {
+		e[i / 2] = s[i];
+		o[i / 2] = s[i + 1];
+	}
+}
+
+// as af_daub_tap_avx2, 8 pairs
+template<int P, int K>
+__attribute__((target("avx512f")))
+static inline void af_daub_tap_avx512(const double *e, const double *o,
+		__m512d &a, __m512d &b) {
+
+	const double *c = af_daub_coef<P>::c;
+	__m512d ve = _mm512_loadu_pd(e + K / 2);
+	__m512d vo = _mm512_loadu_pd(o + K / 2);
+
+	if (P == 4 && K == 0) {
+		a = _mm512_mul_pd(_mm512_set1_pd(c[0]), ve);
+		b = _mm512_mul_pd(_mm512_set1_pd(c[3]), ve);
+	} else {
+		a = _mm512_add_pd(a, _mm512_mul_pd(_mm512_set1_pd(c[K]), ve));
+		b = _mm512_add_pd(b, _mm512_mul_pd(_mm512_set1_pd(c[P - 1 - K]), ve));
+	}
+	a = _mm512_add_pd(a, _mm512_mul_pd(_mm512_set1_pd(c[K + 1]), vo));
+	b = _mm512_sub_pd(b, _mm512_mul_pd(_mm512_set1_pd(c[P - 2 - K]), vo));
+}
+
+template<int P, int K, int NV> struct af_daub_taps_avx512 {
+	__attribute__((target("avx512f")))
+	static inline void add(const double *e, const double *o, __m512d *a,
+			__m512d *b) {
+
+		int v;
+
+		for (v = 0; v < NV; v++)
+			af_daub_tap_avx512<P, K>(e + 8 * v, o + 8 * v, a[v], b[v]);
+		af_daub_taps_avx512<P, K + 2, NV>::add(e, o, a, b);
+	}
+};
+
+template<int P, int NV> struct af_daub_taps_avx512<P, P, NV> {
+	__attribute__((target("avx512f")))
+	static inline void add(const double *, const double *, __m512d *,
+			__m512d *) {
+	}
+};
+
+template<int P, int NV> struct af_daub_pairs_avx512 {
+	__attribute__((target("avx512f")))
+	static inline void run(const double *e, const double *o, double *za,
+			double *zb) {
+
+		__m512d a[NV], b[NV];
+		int v;
+
+		for (v = 0; v < NV; v++)
+			a[v] = b[v] = _mm512_setzero_pd();
+		af_daub_taps_avx512<P, 0, NV>::add(e, o, a, b);
+		for (v = 0; v < NV; v++) {
+			_mm512_storeu_pd(za + 8 * v, a[v]);
+			_mm512_storeu_pd(zb + 8 * v, b[v]);
+		}
+	}
+};
+
+template<int NV> struct af_daub_pairs_avx512<2, NV> {
+	__attribute__((target("avx512f")))
+	static inline void run(const double *e, const double *o, double *za,
+			double *zb) {
+
+		const __m512d c0 = _mm512_set1_pd(af_daub_coef<2>::c[0]);
+		const __m512d c1 = _mm512_set1_pd(af_daub_coef<2>::c[1]);
+		__m512d ve, vo;
+		int v;
+
+		for (v = 0; v < NV; v++) {
+			ve = _mm512_loadu_pd(e + 8 * v);
+			vo = _mm512_loadu_pd(o + 8 * v);
+			_mm512_storeu_pd(za + 8 * v, _mm512_mul_pd(c0, _mm512_add_pd(ve, vo)));
+			_mm512_storeu_pd(zb + 8 * v, _mm512_mul_pd(c1, _mm512_sub_pd(ve, vo)));
+		}
+	}
+};
+
+// as af_daub_transform_avx2, 16 or 8 pairs per step
+template<int P>
+__attribute__((target("avx512f")))
+static void af_daub_transform_avx512(int n, const double x[], double y[],
+		double z[]) {
+
+	const int minm = P == 2 ? 2 : 4;
+	const double *s = x;
+	double ta[AF_DAUB_REST], tb[AF_DAUB_REST];
+	int i, i0, m, h, ni;
+
+	if (x == y || n < minm) {
+		af_daub_transform<P>(n, x, y, z);
+		return;
+	}
+
+	af_daub_split_avx512(x, n, y, y + n / 2);
+	for (m = n; m >= minm; m /= 2) {
+		h = m / 2;
+		ni = af_daub_interior<P>(m);
+		i0 = ni - ni % 8;
+		af_daub_rest<P>(s, m, ni, i0, ta, tb);
+		for (i = 0; i + 16 <= i0; i += 16)
+			af_daub_pairs_avx512<P, 2>::run(y + i, y + h + i, z + i, z + h + i);
+		if (i < i0)
+			af_daub_pairs_avx512<P, 1>::run(y + i, y + h + i, z + i, z + h + i);
+		for (i = i0; i < h; i++) {
+			z[i] = ta[i - i0];
+			z[h + i] = tb[i - i0];
+		}
+
+		for (i = h; i < m; i++)
+			y[i] = z[i];
+		if (h >= minm)
+			af_daub_split_avx512(z, h, y, y + h / 2);
+		else
+			for (i = 0; i < h; i++)
+				y[i] = z[i];
+		s = z;
+	}
+}
+
+#endif
+
+// implementations of the families, index family / 2 - 1
+static const af_daub_func af_daub_funcs[AF_DAUB_MAX / 2] = {
+		&af_daub_transform<2>, &af_daub_transform<4>, &af_daub_transform<6>,
+		&af_daub_transform<8>, &af_daub_transform<10>, &af_daub_transform<12>,
+		&af_daub_transform<14>, &af_daub_transform<16>, &af_daub_transform<18>,
+		&af_daub_transform<20> };
+
+#ifdef AF_DAUB_X86
+static const af_daub_func af_daub_funcs_avx2[AF_DAUB_MAX / 2] = {
+		&af_daub_transform_avx2<2>, &af_daub_transform_avx2<4>,
+		&af_daub_transform_avx2<6>, &af_daub_transform_avx2<8>,
+		&af_daub_transform_avx2<10>, &af_daub_transform_avx2<12>,
+		&af_daub_transform_avx2<14>, &af_daub_transform_avx2<16>,
+		&af_daub_transform_avx2<18>, &af_daub_transform_avx2<20> };
+
+static const af_daub_func af_daub_funcs_avx512[AF_DAUB_MAX / 2] = {
+		&af_daub_transform_avx512<2>, &af_daub_transform_avx512<4>,
+		&af_daub_transform_avx512<6>, &af_daub_transform_avx512<8>,
+		&af_daub_transform_avx512<10>, &af_daub_transform_avx512<12>,
+		&af_daub_transform_avx512<14>, &af_daub_transform_avx512<16>,
+		&af_daub_transform_avx512<18>, &af_daub_transform_avx512<20> };
+#endif
+
+static const double *const af_daub_coefs[AF_DAUB_MAX / 2] = {
+		af_daub_coef<2>::c, af_daub_coef<4>::c, af_daub_coef<6>::c,
+		af_daub_coef<8>::c, af_daub_coef<10>::c, af_daub_coef<12>::c,
+		af_daub_coef<14>::c, af_daub_coef<16>::c, af_daub_coef<18>::c,
+		af_daub_coef<20>::c };
+
+static inline bool af_daub_family(int family) {
+	return family >= AF_DAUB_MIN && family <= AF_DAUB_MAX && family % 2 == 0;
+}
+
+// true if the CPU supports implementation isa
+static bool af_daub_supported(int isa) {
+	if (isa == AF_DAUB_SCALAR)
+		return true;
+#ifdef AF_DAUB_X86
+	__builtin_cpu_init();
+	if (isa == AF_DAUB_AVX2)
+		return __builtin_cpu_supports("avx2");
+	if (isa == AF_DAUB_AVX512)
+		return __builtin_cpu_supports("avx2")
+				&& __builtin_cpu_supports("avx512f");
+#endif
+	return false;
+}
+
+// selected implementation
+static int af_daub_isa = -1;
+
+static void af_daub_select() {
+	af_daub_isa = AF_DAUB_SCALAR;
+	if (af_daub_supported(AF_DAUB_AVX2))
+		af_daub_isa = AF_DAUB_AVX2;
+	if (af_daub_supported(AF_DAUB_AVX512))
+		af_daub_isa = AF_DAUB_AVX512;
+}
+
+af_daub_func af_daub_transform_isa(int family, int isa) {
+
+	if (!af_daub_family(family) || !af_daub_supported(isa))
+		return NULL;
+#ifdef AF_DAUB_X86
+	if (isa == AF_DAUB_AVX2)
+		return af_daub_funcs_avx2[family / 2 - 1];
+	if (isa == AF_DAUB_AVX512)
+		return af_daub_funcs_avx512[family / 2 - 1];
+#endif
+	return af_daub_funcs[family / 2 - 1];
+}
+
+af_daub_func af_daub_transform_func(int family) {
+	if (af_daub_isa < 0)
+		af_daub_select();
+	return af_daub_transform_isa(family, af_daub_isa);
+}
+
+const char *af_daub_name() {
+	if (af_daub_isa < 0)
+		af_daub_select();
+	return af_daub_isa == AF_DAUB_AVX512 ? "avx512" :
+			af_daub_isa == AF_DAUB_AVX2 ? "avx2" : "scalar";
+}
+
+const double *af_daub_coefficients(int family) {
+	return af_daub_family(family) ? af_daub_coefs[family / 2 - 1] : NULL;
+}
@@ -0,0 +1,239 @@
+/*
+ * af_daub.hpp
+ *
+ * Daubechies transform daubN (N = 2, 4, ..., 20) as one kernel template over
+ * the filter length P: coefficients are compile time constants and the loop
+ * over the taps of a pair is unrolled by af_daub_taps, so each daubN is
+ * compiled to straight code with the coefficients in registers. Only the last
+ * pairs of each level wrap around its end, the others index values directly.
+ * Arithmetic is in the order of the original daubN_transform of wavelet_ms
+ * (the same result, bit for bit)
+ *
+ * AVX2 and AVX-512 versions (af_daub.cpp, selected by the CPU at the first
+ * use) keep the values of each level split to even and odd ones and compute
+ * 8 or 16 interior pairs per step; products and sums are rounded one by one
+ * in the scalar order (no fused multiply-add), so all versions give the same
+ * result
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_DAUB_HPP_
+#define AF_DAUB_HPP_
+
+#define AF_DAUB_MIN 2
+#define AF_DAUB_MAX 20
+
+// coefficients of daubP (defined in af_daub.cpp)
+template<int P> struct af_daub_coef;
+
+template<> struct af_daub_coef<2> {
+	static constexpr double c[2] = {
+			7.071067811865475E-01, 7.071067811865475E-01 };
+};
+
+template<> struct af_daub_coef<4> {
+	static constexpr double c[4] = {
+			0.4829629131445341, 0.8365163037378079, 0.2241438680420133,
+			-0.1294095225512603 };
+};
+
+template<> struct af_daub_coef<6> {
+	static constexpr double c[6] = {
+			0.3326705529500826, 0.8068915093110925, 0.4598775021184915,
+			-0.1350110200102545, -0.08544127388202666, 0.03522629188570953 };
+};
+
+template<> struct af_daub_coef<8> {
+	static constexpr double c[8] = {
+			0.2303778133088964, 0.7148465705529154, 0.6308807679298587,
+			-0.02798376941685985, -0.1870348117190931, 0.03084138183556076,
+			0.03288301166688519, -0.01059740178506903 };
+};
+
+template<> struct af_daub_coef<10> {
+	static constexpr double c[10] = {
+			1.601023979741929E-01, 6.038292697971896E-01, 7.243085284377729E-01,
+			1.384281459013207E-01, -2.422948870663820E-01, -3.224486958463837E-02,
+			7.757149384004571E-02, -6.241490212798274E-03, -1.258075199908199E-02,
+			3.335725285473771E-03 };
+};
+
+template<> struct af_daub_coef<12> {
+	static constexpr double c[12] = {
+			0.1115407433501095E+00, 0.4946238903984533E+00, 0.7511339080210959E+00,
+			0.3152503517091982E+00, -0.2262646939654400E+00, -0.1297668675672625E+00,
+			0.0975016055873225E+00, 0.0275228655303053E+00, -0.0315820393174862E+00,
+			0.0005538422011614E+00, 0.0047772575109455E+00, -0.0010773010853085E+00 };
+};
+
+template<> struct af_daub_coef<14> {
+	static constexpr double c[14] = {
+			7.785205408500917E-02, 3.965393194819173E-01, 7.291320908462351E-01,
+			4.697822874051931E-01, -1.439060039285649E-01, -2.240361849938749E-01,
+			7.130921926683026E-02, 8.061260915108307E-02, -3.802993693501441E-02,
+			-1.657454163066688E-02, 1.255099855609984E-02, 4.295779729213665E-04,
+			-1.801640704047490E-03, 3.537137999745202E-04 };
+};
+
+template<> struct af_daub_coef<16> {
+	static constexpr double c[16] = {
+			5.441584224310400E-02, 3.128715909142999E-01, 6.756307362972898E-01,
+			5.853546836542067E-01, -1.582910525634930E-02, -2.840155429615469E-01,
+			4.724845739132827E-04, 1.287474266204784E-01, -1.736930100180754E-02,
+			-4.408825393079475E-02, 1.398102791739828E-02, 8.746094047405776E-03,
+			-4.870352993451574E-03, -3.917403733769470E-04, 6.754494064505693E-04,
+			-1.174767841247695E-04 };
+};
+
+template<> struct af_daub_coef<18> {
+	static constexpr double c[18] = {
+			3.807794736387834E-02, 2.438346746125903E-01, 6.048231236901111E-01,
+			6.572880780513005E-01, 1.331973858250075E-01, -2.932737832791749E-01,
+			-9.684078322297646E-02, 1.485407493381063E-01, 3.072568147933337E-02,
+			-6.763282906132997E-02, 2.509471148314519E-04, 2.236166212367909E-02,
+			-4.723204757751397E-03, -4.281503682463429E-03, 1.847646883056226E-03,
+			2.303857635231959E-04, -2.519631889427101E-04, 3.934732031627159E-05 };
+};
+
+template<> struct af_daub_coef<20> {
+	static constexpr double c[20] = {
+			2.667005790055555E-02, 1.881768000776914E-01, 5.272011889317255E-01,
+			6.884590394536035E-01, 2.811723436605774E-01, -2.498464243273153E-01,
+			-1.959462743773770E-01, 1.273693403357932E-01, 9.305736460357235E-02,
+			-7.139414716639708E-02, -2.945753682187581E-02, 3.321267405934100E-02,
+			3.606553566956169E-03, -1.073317548333057E-02, 1.395351747052901E-03,
+			1.992405295185056E-03, -6.858566949597116E-04, -1.164668551292854E-04,
+			9.358867032006959E-05, -1.326420289452124E-05 };
+};
+
+// index of value i of level with m values, mirrored behind its end as i4_wrap
+inline int af_daub_wrap(int i, int m) {
+	return i <= m - 1 ? i : m - 1 - i % m;
+}
+
+// index of value i, wrapped only in the tail of the level (W true), interior
+// pairs (all their values inside the level) index directly
+template<bool W> inline int af_daub_index(int i, int m) {
+	return W ? af_daub_wrap(i, m) : i;
+}
+
+// taps K, K + 1, ... of pair starting at value j of level with m values,
+// added to approximation a and detail b
+template<int P, int K, bool W> struct af_daub_taps {
+	static inline void add(const double *y, int j, int m, double &a, double &b) {
+		const double *c = af_daub_coef<P>::c;
+		int j0 = af_daub_index<W>(j + K, m);
+		int j1 = af_daub_index<W>(j + K + 1, m);
+
+		a = a + c[K] * y[j0] + c[K + 1] * y[j1];
+		b = b + c[P - 1 - K] * y[j0] - c[P - 2 - K] * y[j1];
+		af_daub_taps<P, K + 2, W>::add(y, j, m, a, b);
+	}
+};
+
+template<int P, bool W> struct af_daub_taps<P, P, W> {
+	static inline void add(const double *, int, int, double &, double &) {
+	}
+};
+
+// pair (approximation a, detail b) starting at value j of level with m values
+template<int P, bool W> struct af_daub_kernel {
+	static inline void pair(const double *y, int j, int m, double &a, double &b) {
+		a = 0.0;
+		b = 0.0;
+		af_daub_taps<P, 0, W>::add(y, j, m, a, b);
+	}
+};
+
+// daub4 and daub2 (Haar) sum without the leading zero as their originals
+template<bool W> struct af_daub_kernel<4, W> {
+	static inline void pair(const double *y, int j, int m, double &a, double &b) {
+		const double *c = af_daub_coef<4>::c;
+		int j0 = af_daub_index<W>(j, m);
+		int j1 = af_daub_index<W>(j + 1, m);
+		int j2 = af_daub_index<W>(j + 2, m);
+		int j3 = af_daub_index<W>(j + 3, m);
+
+		a = c[0] * y[j0] + c[1] * y[j1] + c[2] * y[j2] + c[3] * y[j3];
+		b = c[3] * y[j0] - c[2] * y[j1] + c[1] * y[j2] - c[0] * y[j3];
+	}
+};
+
+template<bool W> struct af_daub_kernel<2, W> {
+	static inline void pair(const double *y, int j, int, double &a, double &b) {
+		const double *c = af_daub_coef<2>::c;
+
+		a = c[0] * (y[j] + y[j + 1]);
+		b = c[1] * (y[j] - y[j + 1]);
+	}
+};
+
+// number of pairs of level with m values not reaching its end (the pair
+// starting at 2 * i uses values 2 * i .. 2 * i + P - 1)
+template<int P> inline int af_daub_interior(int m) {
+	return m >= P ? (m - P) / 2 + 1 : 0;
+}
+
+// pairs i, i + 1, ... of level with m values from y to z (approximations to
+// z[0 .. m / 2), details behind them); interior pairs run without wrapping,
+// the last (P - 2) / 2 pairs with it
+template<int P> inline void af_daub_level(const double *y, int m, double *z,
+		int i) {
+
+	int ni = af_daub_interior<P>(m);
+	double a, b;
+
+	for (; i < ni; i++) {
+		af_daub_kernel<P, false>::pair(y, 2 * i, m, a, b);
+		z[i] = a;
+		z[i + m / 2] = b;
+	}
+	for (; i < m / 2; i++) {
+		af_daub_kernel<P, true>::pair(y, 2 * i, m, a, b);
+		z[i] = a;
+		z[i + m / 2] = b;
+	}
+}
+
+// daubP transform of x (n values, power of 2) to y, z is workspace of n values
+// (y may be x); levels down to 4 values, daub2 down to 2. Scalar reference of
+// the vector implementations in af_daub.cpp
+template<int P> void af_daub_transform(int n, const double x[], double y[],
+		double z[]) {
+
+	const int minm = P == 2 ? 2 : 4;
+	int i, m;
+
+	for (i = 0; i < n; i++)
+		y[i] = x[i];
+
+	for (m = n; m >= minm; m /= 2) {
+		af_daub_level<P>(y, m, z, 0);
+		for (i = 0; i < m; i++)
+			y[i] = z[i];
+	}
+}
+
+typedef void (*af_daub_func)(int, const double *, double *, double *);
+
+// implementations of the transform
+#define AF_DAUB_SCALAR 0
+#define AF_DAUB_AVX2 1
+#define AF_DAUB_AVX512 2
+
+// daub<family> of the fastest implementation available on this CPU,
+// NULL if family is not 2, 4, ..., 20
+af_daub_func af_daub_transform_func(int family);
+
+// daub<family> of implementation isa (AF_DAUB_...), NULL if family is not
+// 2, 4, ..., 20 or the CPU does not support it
+af_daub_func af_daub_transform_isa(int family, int isa);
+
+// name of the fastest implementation ("avx512", "avx2" or "scalar")
+const char *af_daub_name();
+
+// coefficients of daub<family>, NULL if family is not 2, 4, ..., 20
+const double *af_daub_coefficients(int family);
+
+#endif /* AF_DAUB_HPP_ */
@@ -0,0 +1,324 @@
+/*
+ * af_decomp.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+#include <ctime>
+#include <zlib.h>
+#ifdef AF_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "af_decomp.hpp"
+#include "af_input.hpp"
+
+// compressed input of producer thread
+struct af_decomp_input {
+	af_decomp *d;
+	bool memused;	// data in memory already given
+	char *raw;		// buffer for data read from fd
+	const char *p;	// compressed data
+	size_t n;
+};
+
+int af_decomp_format(const char *b, size_t n) {
+	if (n >= 2 && (unsigned char) b[0] == 0x1f && (unsigned char) b[1] == 0x8b)
+		return AF_DECOMP_GZIP;
+	if (n >= 4 && (unsigned char) b[0] == 0x28 && (unsigned char) b[1] == 0xb5
+			&& (unsigned char) b[2] == 0x2f && (unsigned char) b[3] == 0xfd)
+		return AF_DECOMP_ZSTD;
+	return AF_DECOMP_NONE;
+}
+
+const char *af_decomp_name(int format) {
+	switch (format) {
+	case AF_DECOMP_GZIP:
+		return "gzip";
+	case AF_DECOMP_ZSTD:
+		return "zstd";
+	}
+	return "none";
+}
+
+bool af_decomp_supported(int format) {
+#ifdef AF_WITH_ZSTD
+	return format == AF_DECOMP_GZIP || format == AF_DECOMP_ZSTD;
+#else
+	return format == AF_DECOMP_GZIP;
+#endif
+}
+
+// waiting of producer for free block or of consumer for data
+static void af_decomp_backoff(unsigned &spins) {
+	struct timespec ts = { 0, 50000 };
+
+	if (++spins < 64)
+		std::this_thread::yield();
+	else
+		nanosleep(&ts, NULL);
+}
+
+// next compressed data to in.p, in.n, false at the end of input
+static bool af_decomp_more(af_decomp_input &in) {
+
+	long got;
+
+	if (!in.memused) {
+		in.memused = true;
+		if (in.d->memn > 0) {
+			in.p = in.d->mem;
+			in.n = in.d->memn;
+			return true;
+		}
+	}
+
+	if (in.d->fd < 0)
+		return false;
+
+	got = af_fd_read(&in.d->fd, in.raw, AF_DECOMP_RAW);
+	if (got <= 0)
+		return false;
+
+	in.p = in.raw;
+	in.n = got;
+	return true;
+}
+
+// waits until block t can be written, false if consumer requested stop
+static bool af_decomp_slot(af_decomp &d, unsigned t) {
+
+	unsigned spins = 0;
+
+	while (t - d.head.load(std::memory_order_acquire) >= AF_DECOMP_SLOTS) {
+		if (d.stop.load(std::memory_order_relaxed))
+			return false;
+		af_decomp_backoff(spins);
+	}
+
+	return true;
+}
+
+// gzip (incl. concatenated members), returns 1 at the end, -1 on error
+static int af_decomp_gzip(af_decomp &d, af_decomp_input &in) {
+
+	z_stream zs;
+	af_decomp_block *b;
+	unsigned t = 0;
+	int state = 0;
+	int ret;
+	bool flushed = true;	// all output of given input taken
+	bool between = false;	// end of member, next one not started
+
+	memset(&zs, 0, sizeof(zs));
+	if (inflateInit2(&zs, 15 + 32) != Z_OK)
+		return -1;
+
+	while (state == 0) {
+		if (!af_decomp_slot(d, t))
+			break;
+
+		b = &d.slots[t % AF_DECOMP_SLOTS];
+		zs.next_out = (Bytef *) b->data;
+		zs.avail_out = AF_DECOMP_BLOCK;
+
+		while (state == 0 && zs.avail_out > 0) {
+			if (zs.avail_in == 0 && flushed) {
+				if (!af_decomp_more(in)) {
+					state = between ? 1 : -1;	// else truncated
+					break;
+				}
+				zs.next_in = (Bytef *) in.p;
+				zs.avail_in = in.n;
+			}
+			if (between) {
+				inflateReset(&zs);
+				between = false;
+			}
+
+			ret = inflate(&zs, Z_NO_FLUSH);
+			flushed = zs.avail_out > 0;
+			if (ret == Z_STREAM_END)
+				between = true;
+			else if (ret == Z_BUF_ERROR)
+				flushed = true;		// no progress without more input
+			else if (ret != Z_OK)
+				state = -1;
+		}
+
+		b->n = AF_DECOMP_BLOCK - zs.avail_out;
+		if (b->n > 0)
+			d.tail.store(++t, std::memory_order_release);
+	}
+
+	inflateEnd(&zs);
+	return state == -1 ? -1 : 1;
+}
+
+#ifdef AF_WITH_ZSTD
+// zstd (incl. more frames), returns 1 at the end, -1 on error
+static int af_decomp_zstd(af_decomp &d, af_decomp_input &in) {
+
+	ZSTD_DStream *zd;
+	ZSTD_inBuffer zin = { NULL, 0, 0 };
+	ZSTD_outBuffer zout;
+	af_decomp_block *b;
+	unsigned t = 0;
+	int state = 0;
+	size_t ret = 1;		// 0 at the end of frame
+	bool flushed = true;
+
+	zd = ZSTD_createDStream();
+	if (zd == NULL || ZSTD_isError(ZSTD_initDStream(zd))) {
+		ZSTD_freeDStream(zd);
+		return -1;
+	}
+
+	while (state == 0) {
+		if (!af_decomp_slot(d, t))
+			break;
+
+		b = &d.slots[t % AF_DECOMP_SLOTS];
+		zout.dst = b->data;
+		zout.size = AF_DECOMP_BLOCK;
+		zout.pos = 0;
+
+		while (state == 0 && zout.pos < zout.size) {
+			if (zin.pos == zin.size && flushed) {
+				if (!af_decomp_more(in)) {
+					state = ret == 0 ? 1 : -1;	// else truncated
+					break;
+				}
+				zin.src = in.p;
+				zin.size = in.n;
+				zin.pos = 0;
+			}
+
+			ret = ZSTD_decompressStream(zd, &zout, &zin);
+			flushed = zout.pos < zout.size;
+			if (ZSTD_isError(ret))
+				state = -1;
+		}
+
+		b->n = zout.pos;
+		if (b->n > 0)
+			d.tail.store(++t, std::memory_order_release);
+	}
+
+	ZSTD_freeDStream(zd);
+	return state == -1 ? -1 : 1;
+}
+#endif
+
+// producer thread
+static void af_decomp_run(af_decomp *d) {
+
+	af_decomp_input in;
+	int state = -1;
+
+	in.d = d;
+	in.memused = false;
+	in.raw = new char[AF_DECOMP_RAW];
+	in.p = NULL;
+	in.n = 0;
+
+	if (d->format == AF_DECOMP_GZIP)
+		state = af_decomp_gzip(*d, in);
+#ifdef AF_WITH_ZSTD
+	else if (d->format == AF_DECOMP_ZSTD)
+		state = af_decomp_zstd(*d, in);
+#endif
+
+	delete[] in.raw;
+	d->done.store(state, std::memory_order_release);
+}
+
+int af_decomp_open(af_decomp &d, int format, const char *mem, size_t memn,
+		int fd) {
+
+	int i;
+
+	if (!af_decomp_supported(format))
+		return 1;
+
+	d.format = format;
+	d.mem = mem;
+	d.memn = memn;
+	d.fd = fd;
+	for (i = 0; i < AF_DECOMP_SLOTS; i++) {
+		d.slots[i].data = new char[AF_DECOMP_BLOCK];
+		d.slots[i].n = 0;
+	}
+	d.head.store(0);
+	d.tail.store(0);
+	d.done.store(0);
+	d.stop.store(0);
+	d.pos = 0;
+
+	try {
+		d.worker = std::thread(af_decomp_run, &d);
+	} catch (const std::exception &exc) {
+		for (i = 0; i < AF_DECOMP_SLOTS; i++)
+			delete[] d.slots[i].data;
+		return 1;
+	}
+
+	return 0;
+}
+
+void af_decomp_close(af_decomp &d) {
+
+	int i;
+
+	if (!d.worker.joinable())
+		return;
+
+	d.stop.store(1);
+	d.worker.join();
+
+	for (i = 0; i < AF_DECOMP_SLOTS; i++) {
+		delete[] d.slots[i].data;
+		d.slots[i].data = NULL;
+	}
+}
+
+// copies decompressed blocks in order, producer decompresses next ones meanwhile
+long af_decomp_read(void *ctx, char *dst, size_t cap) {
+
+	af_decomp &d = *(af_decomp *) ctx;
+	af_decomp_block *b;
+	unsigned spins = 0;
+	unsigned h;
+	size_t n;
+
+	for (;;) {
+		h = d.head.load(std::memory_order_relaxed);
+
+		if (h != d.tail.load(std::memory_order_acquire)) {
+			b = &d.slots[h % AF_DECOMP_SLOTS];
+			n = b->n - d.pos;
+			if (n > cap)
+				n = cap;
+			memcpy(dst, b->data + d.pos, n);
+			d.pos += n;
+
+			// block consumed, producer may reuse it
+			if (d.pos >= b->n) {
+				d.pos = 0;
+				d.head.store(h + 1, std::memory_order_release);
+			}
+			return n;
+		}
+
+		// producer finished (blocks published before done are taken first)
+		if (d.done.load(std::memory_order_acquire) != 0) {
+			if (h != d.tail.load(std::memory_order_acquire))
+				continue;
+			return d.done.load() > 0 ? 0 : -1;
+		}
+
+		af_decomp_backoff(spins);
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ * af_decomp.hpp
+ *
+ * Compressed input (gzip, zstd if built with AF_WITH_ZSTD): data are decompressed
+ * on a separate thread and handed to the text reader in blocks
+ * through a single producer/single consumer lock-free queue
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_DECOMP_HPP_
+#define AF_DECOMP_HPP_
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+
+// compression formats (detected from magic bytes)
+#define AF_DECOMP_NONE 0
+#define AF_DECOMP_GZIP 1
+#define AF_DECOMP_ZSTD 2
+
+// size of decompressed block, number of blocks in queue
+#define AF_DECOMP_BLOCK (1024 * 1024)
+#define AF_DECOMP_SLOTS 4
+// size of compressed data read at once from file descriptor
+#define AF_DECOMP_RAW (256 * 1024)
+
+// decompressed block
+struct af_decomp_block {
+	char *data;
+	size_t n;
+};
+
+// decompressing reader
+// compressed data: first n bytes in memory (whole memory mapped file
+// or bytes already read from fd), then the rest read from fd (if fd >= 0)
+struct af_decomp {
+	int format;
+	const char *mem;
+	size_t memn;
+	int fd;
+	af_decomp_block slots[AF_DECOMP_SLOTS];
+	std::atomic<unsigned> head;	// next block to consume (consumer only writes)
+	std::atomic<unsigned> tail;	// next block to produce (producer only writes)
+	std::atomic<int> done;		// producer finished: 1 at the end of data, -1 on error
+	std::atomic<int> stop;		// consumer requests end of producer
+	size_t pos;					// consumed bytes of head block
+	std::thread worker;
+};
+
+// format of data starting with b[0..n)
+int af_decomp_format(const char *b, size_t n);
+// name of format
+const char *af_decomp_name(int format);
+// false if format is not supported in this build
+bool af_decomp_supported(int format);
+
+// starts decompression thread, returns 0 if ok
+int af_decomp_open(af_decomp &d, int format, const char *mem, size_t memn,
+		int fd);
+void af_decomp_close(af_decomp &d);
+
+// source for af_text_open_source, ctx points to af_decomp
+// returns 0 at the end of data, < 0 if data are corrupted or truncated
+long af_decomp_read(void *ctx, char *dst, size_t cap);
+
+#endif /* AF_DECOMP_HPP_ */
@@ -0,0 +1,133 @@
+/*
+ * af_dwt.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstddef>
+#include <string>
+
+#include "af_dwt.hpp"
+#include "wavelet_ms.hpp"
+
+// index of value i of level with m values, mirrored behind its end as i4_wrap
+static inline int af_dwt_wrap(int i, int m) {
+	return i <= m - 1 ? i : m - 1 - i % m;
+}
+
+// values of level l start at sum of sizes of levels before it
+static inline double *af_dwt_level(af_dwt &d, int l) {
+	return &d.lev[2 * d.n - 2 * (d.n >> l)];
+}
+
+// smallest level transformed (daub2 down to 2 values, others to 4)
+static inline int af_dwt_minm(const af_dwt &d) {
+	return d.family == 2 ? 2 : 4;
+}
+
+static void af_dwt_value(af_dwt &d, int l, double v);
+
+// pair i of level l, arithmetic in the order of daubN_transform
+static void af_dwt_pair(af_dwt &d, int l, int i) {
+
+	const double *c = d.c;
+	const double *y = af_dwt_level(d, l);
+	int m = d.n >> l;
+	int j = 2 * i;
+	int j0, j1, j2, j3, k;
+	double a, b;
+
+	if (d.family == 2) {
+		a = c[0] * (y[j] + y[j + 1]);
+		b = c[1] * (y[j] - y[j + 1]);
+	} else if (d.family == 4) {
+		j0 = af_dwt_wrap(j, m);
+		j1 = af_dwt_wrap(j + 1, m);
+		j2 = af_dwt_wrap(j + 2, m);
+		j3 = af_dwt_wrap(j + 3, m);
+		a = c[0] * y[j0] + c[1] * y[j1] + c[2] * y[j2] + c[3] * y[j3];
+		b = c[3] * y[j0] - c[2] * y[j1] + c[1] * y[j2] - c[0] * y[j3];
+	} else {
+		a = 0.0;
+		b = 0.0;
+		for (k = 0; k < d.p; k = k + 2) {
+			j0 = af_dwt_wrap(j + k, m);
+			j1 = af_dwt_wrap(j + k + 1, m);
+			a = a + c[k] * y[j0] + c[k + 1] * y[j1];
+			b = b + c[d.p - k] * y[j0] - c[d.p - k - 1] * y[j1];
+		}
+	}
+
+	// detail stays at its place, approximation goes to the next level
+	d.out[m / 2 + i] = b;
+	d.order[d.nready++] = m / 2 + i;
+	if (m / 2 >= af_dwt_minm(d))
+		af_dwt_value(d, l + 1, a);
+	else {
+		d.out[i] = a;
+		d.order[d.nready++] = i;
+	}
+}
+
+// appends value v to level l, computes pairs not reaching its end
+static void af_dwt_value(af_dwt &d, int l, double v) {
+
+	int m = d.n >> l;
+
+	af_dwt_level(d, l)[d.cnt[l]++] = v;
+	while (d.done[l] < m / 2 && 2 * d.done[l] + d.p < d.cnt[l]
+			&& 2 * d.done[l] + d.p < m)
+		af_dwt_pair(d, l, d.done[l]++);
+}
+
+int af_dwt_init(af_dwt &d, int family, int n) {
+
+	int m;
+
+	d.c = daub_transform_coefficients(family);
+	if (d.c == NULL || n < 4 || (n & (n - 1)) != 0)
+		return 1;
+
+	d.n = n;
+	d.family = family;
+	d.p = family - 1;
+	d.levels = 0;
+	for (m = n; m >= af_dwt_minm(d); m /= 2)
+		d.levels++;
+	d.lev.assign(2 * n, 0.0);
+	d.cnt.assign(d.levels, 0);
+	d.done.assign(d.levels, 0);
+	d.out.assign(n, 0.0);
+	d.order.assign(n, 0);
+	d.nready = 0;
+	d.used = false;
+
+	return 0;
+}
+
+void af_dwt_reset(af_dwt &d) {
+	d.cnt.assign(d.levels, 0);
+	d.done.assign(d.levels, 0);
+	d.nready = 0;
+}
+
+void af_dwt_push(af_dwt &d, double x) {
+
+	int l, m;
+
+	af_dwt_value(d, 0, x);
+	if (d.cnt[0] < d.n)
+		return;
+
+	// pairs wrapping around the end of levels, level by level
+	for (l = 0; l < d.levels; l++) {
+		m = d.n >> l;
+		while (d.done[l] < m / 2)
+			af_dwt_pair(d, l, d.done[l]++);
+	}
+}
+
+bool af_dwt_finished(const af_dwt &d) {
+	return d.cnt[0] == d.n;
+}
@@ -0,0 +1,46 @@
+/*
+ * af_dwt.hpp
+ *
+ * Streaming Daubechies transform (the same result as daubN_transform of
+ * wavelet_ms, bit for bit): pairs of coefficients of each level are computed
+ * as soon as the values they need arrive, approximation coefficients are
+ * passed to the next level. Only coefficients wrapping around the end of
+ * each level (mirrored values) remain after the last value, i.e. O(p log n)
+ * work instead of the whole transform
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_DWT_HPP_
+#define AF_DWT_HPP_
+
+#include <vector>
+
+struct af_dwt {
+	int n;						// number of values (power of 2)
+	int family;					// daubN, N = 2, 4, ..., 20
+	const double *c;			// coefficients of daubN_transform
+	int p;						// family - 1
+	int levels;
+	std::vector<double> lev;	// values of levels (level l: n >> l values)
+	std::vector<int> cnt;		// number of values of level received
+	std::vector<int> done;		// number of pairs of level computed
+	std::vector<double> out;	// transformed vector
+	std::vector<int> order;		// items of out in order of computation
+	int nready;					// number of items of out computed
+	bool used;					// in use by a pattern
+};
+
+// prepares transform daub<family> of n values (n power of 2, >= 4), returns 0 if ok
+int af_dwt_init(af_dwt &d, int family, int n);
+
+// starts new transform
+void af_dwt_reset(af_dwt &d);
+
+// next value, the transform is finished by the n-th one
+void af_dwt_push(af_dwt &d, double x);
+
+// true if all n values pushed (d.out is the transformed vector)
+bool af_dwt_finished(const af_dwt &d);
+
+#endif /* AF_DWT_HPP_ */
@@ -0,0 +1,420 @@
+/*
+ * af_engine.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "af_engine.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AF_ENGINE_X86
+#endif
+
+// arrays aligned to 64 bytes (cache line, whole vectors)
+static void *af_engine_alloc(size_t n) {
+	void *p;
+
+	if (posix_memalign(&p, 64, n == 0 ? 64 : n) != 0)
+		return NULL;
+	memset(p, 0, n);
+	return p;
+}
+
+void af_engine_init(af_engine &e, int n, int nwin) {
+
+	int c;
+
+	e.n = n;
+	e.lastval = (double *) af_engine_alloc(n * sizeof(double));
+	e.diffavg = (float *) af_engine_alloc(n * sizeof(float));
+	e.busy = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.isalarm = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.iswait = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.numthresholded = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.patternid = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.ispattern = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.windows = (af_window *) af_engine_alloc(n * nwin * sizeof(af_window));
+	e.nwin = nwin;
+	e.genpattern_count = (int32_t *) af_engine_alloc(n * sizeof(int32_t));
+	e.alarmraisetime = (long long *) af_engine_alloc(n * sizeof(long long));
+	e.genpattern_time = (long long *) af_engine_alloc(n * sizeof(long long));
+	e.scalar = (int *) af_engine_alloc(n * sizeof(int));
+
+	for (c = 0; c < n; c++)
+		e.busy[c] = 1;
+}
+
+void af_engine_free(af_engine &e) {
+	free(e.lastval);
+	free(e.diffavg);
+	free(e.busy);
+	free(e.isalarm);
+	free(e.iswait);
+	free(e.numthresholded);
+	free(e.patternid);
+	free(e.ispattern);
+	free(e.windows);
+	free(e.genpattern_count);
+	free(e.alarmraisetime);
+	free(e.genpattern_time);
+	free(e.scalar);
+	e.n = 0;
+}
+
+// channels c0..n, k channels already found for scalar processing, returns new k
+// (whole scalar version and tail of the vector version)
+static int af_engine_tail(af_engine &e, const double *cur, double multiplicator,
+		int n_amend, int c0, int k) {
+
+	double diff;
+	int c;
+
+	for (c = c0; c < e.n; c++) {
+		diff = fabs(cur[c] - e.lastval[c]);
+		if (e.busy[c] || !(diff < multiplicator * e.diffavg[c])) {
+			e.scalar[k++] = c;
+			continue;
+		}
+		e.diffavg[c] = (e.diffavg[c] * (n_amend - 1) + diff) / n_amend;
+		e.lastval[c] = cur[c];
+	}
+
+	return k;
+}
+
+static int af_engine_tick_scalar(af_engine &e, const double *cur,
+		double multiplicator, int n_amend) {
+	return af_engine_tail(e, cur, multiplicator, n_amend, 0, 0);
+}
+
+#ifdef AF_ENGINE_X86
+
+// 4 channels per step, products and sums rounded as in scalar code
+// (float product, double sum and quotient, float result)
+__attribute__((target("avx2")))
+static int af_engine_tick_avx2(af_engine &e, const double *cur,
+		double multiplicator, int n_amend) {
+
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d mul = _mm256_set1_pd(multiplicator);
+	const __m256d div = _mm256_set1_pd((double) n_amend);
+	const __m128 keep = _mm_set1_ps((float) (n_amend - 1));
+	const __m256i zero = _mm256_setzero_si256();
+	__m256d x, diff, avg;
+	__m128 af, na;
+	__m256i busy;
+	float nav[4];
+	unsigned int need, j;
+	int k = 0;
+	int c;
+
+	for (c = 0; c + 4 <= e.n; c += 4) {
+		x = _mm256_loadu_pd(cur + c);
+		diff = _mm256_andnot_pd(sign,
+				_mm256_sub_pd(x, _mm256_load_pd(e.lastval + c)));
+		af = _mm_load_ps(e.diffavg + c);
+		avg = _mm256_cvtps_pd(af);
+
+		// threshold crossed (or not comparable) or busy channel
+		busy = _mm256_cvtepi32_epi64(
+				_mm_load_si128((const __m128i *) (e.busy + c)));
+		need = _mm256_movemask_pd(
+				_mm256_cmp_pd(diff, _mm256_mul_pd(mul, avg), _CMP_NLT_UQ))
+				| (~_mm256_movemask_pd(
+						_mm256_castsi256_pd(_mm256_cmpeq_epi64(busy, zero)))
+						& 15);
+
+		na = _mm256_cvtpd_ps(
+				_mm256_div_pd(
+						_mm256_add_pd(_mm256_cvtps_pd(_mm_mul_ps(af, keep)),
+								diff), div));
+
+		if (need == 0) {
+			_mm_store_ps(e.diffavg + c, na);
+			_mm256_store_pd(e.lastval + c, x);
+			continue;
+		}
+
+		_mm_storeu_ps(nav, na);
+		for (j = 0; j < 4; j++) {
+			if (need & (1 << j))
+				e.scalar[k++] = c + j;
+			else {
+				e.diffavg[c + j] = nav[j];
+				e.lastval[c + j] = cur[c + j];
+			}
+		}
+	}
+
+	return af_engine_tail(e, cur, multiplicator, n_amend, c, k);
+}
+
+#endif
+
+// lower bound of diffavg decay, the margin covers relative rounding error
+// of one amendment (float product and result) for each value
+void af_block_decay(double *decay, int n, int n_amend) {
+
+	const double r = (double) (n_amend - 1) / n_amend * (1 - ldexp(1.0, -20));
+	int i;
+
+	if (n > 0)
+		decay[0] = 1;
+	for (i = 1; i < n; i++)
+		decay[i] = decay[i - 1] * r;
+}
+
+// values i0..n, returns number of leading quiet values from 0
+// (whole scalar version and tail of the vector version)
+static int af_block_quiet_tail(const double *x, int n, double lastval,
+		double bound, const double *decay, int i0) {
+	int i;
+
+	for (i = i0; i < n; i++)
+		if (!(fabs(x[i] - (i ? x[i - 1] : lastval)) < bound * decay[i]))
+			break;
+	return i;
+}
+
+static int af_block_quiet_scalar(const double *x, int n, double lastval,
+		double bound, const double *decay) {
+	return af_block_quiet_tail(x, n, lastval, bound, decay, 0);
+}
+
+#ifdef AF_ENGINE_X86
+
+// 4 values per step, stops at the first step with a candidate value
+__attribute__((target("avx2")))
+static int af_block_quiet_avx2(const double *x, int n, double lastval,
+		double bound, const double *decay) {
+
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d b = _mm256_set1_pd(bound);
+	__m256d prev, cur, d;
+	int i;
+
+	if (n < 5)
+		return af_block_quiet_tail(x, n, lastval, bound, decay, 0);
+
+	// the first step uses lastval as predecessor
+	if (af_block_quiet_tail(x, 1, lastval, bound, decay, 0) == 0)
+		return 0;
+
+	for (i = 1; i + 4 <= n; i += 4) {
+		prev = _mm256_loadu_pd(x + i - 1);
+		cur = _mm256_loadu_pd(x + i);
+		d = _mm256_andnot_pd(sign, _mm256_sub_pd(cur, prev));
+		if (_mm256_movemask_pd(
+				_mm256_cmp_pd(d,
+						_mm256_mul_pd(b, _mm256_loadu_pd(decay + i)),
+						_CMP_LT_OQ)) != 15)
+			break;
+	}
+
+	return af_block_quiet_tail(x, n, lastval, bound, decay, i);
+}
+
+#endif
+
+// smallest diffavg for which the decay bound holds
+#define AF_BLOCK_MIN_DIFFAVG 1e-30
+
+static int (*af_block_quiet_func)(const double *, int, double, double,
+		const double *) = NULL;
+
+int af_block_quiet(const double *x, int n, double lastval, float diffavg,
+		double multiplicator, const double *decay) {
+
+	if (af_block_quiet_func == NULL) {
+		af_block_quiet_func = &af_block_quiet_scalar;
+#ifdef AF_ENGINE_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			af_block_quiet_func = &af_block_quiet_avx2;
+#endif
+	}
+
+	// no proof while diffavg may get close to float underflow
+	// (relative rounding error not bounded there)
+	if (!(diffavg >= AF_BLOCK_MIN_DIFFAVG))
+		return 0;
+	while (n > 0 && diffavg * decay[n - 1] < AF_BLOCK_MIN_DIFFAVG)
+		n /= 2;
+
+	return (*af_block_quiet_func)(x, n, lastval, multiplicator * diffavg,
+			decay);
+}
+
+void af_block_amend(const double *x, int n, double &lastval, float &diffavg,
+		int n_amend) {
+
+	double diff;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		diff = fabs(x[i] - lastval);
+		diffavg = (diffavg * (n_amend - 1) + diff) / n_amend;
+		lastval = x[i];
+	}
+}
+
+void af_block_weights(double *g, int n, int n_amend) {
+
+	const double r = (double) (n_amend - 1) / n_amend;
+	int k;
+
+	g[0] = 1;
+	for (k = 1; k <= n; k++)
+		g[k] = g[k - 1] * r;
+}
+
+// values i0..i1 of block of n values, max |diff| and weighted sum added to m, s
+// (whole scalar version, head and tail of the vector version)
+static void af_block_summary_part(const double *x, int n, double lastval,
+		const double *g, int i0, int i1, double &m, double &s) {
+
+	const double w = 1 - g[1];
+	double d;
+	int i;
+
+	for (i = i0; i < i1; i++) {
+		d = fabs(x[i] - (i ? x[i - 1] : lastval));
+		if (!(d <= m))
+			m = d;	// NaN kept, block never proven quiet
+		s += w * g[n - 1 - i] * d;
+	}
+}
+
+static double af_block_summary_scalar(const double *x, int n, double lastval,
+		const double *g, double &wsum) {
+
+	double m = 0;
+
+	wsum = 0;
+	af_block_summary_part(x, n, lastval, g, 0, n, m, wsum);
+	return m;
+}
+
+#ifdef AF_ENGINE_X86
+
+// 4 values per step, weights g[n - 1 - i] loaded in reverse order
+__attribute__((target("avx2")))
+static double af_block_summary_avx2(const double *x, int n, double lastval,
+		const double *g, double &wsum) {
+
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d w = _mm256_set1_pd(1 - g[1]);
+	__m256d d, m = _mm256_setzero_pd(), s = _mm256_setzero_pd();
+	__m256d unord = _mm256_setzero_pd();
+	double mv[4], sv[4], r = 0;
+	int i, j;
+
+	wsum = 0;
+	if (n < 5) {
+		af_block_summary_part(x, n, lastval, g, 0, n, r, wsum);
+		return r;
+	}
+
+	// the first value uses lastval as predecessor
+	af_block_summary_part(x, n, lastval, g, 0, 1, r, wsum);
+
+	for (i = 1; i + 4 <= n; i += 4) {
+		d = _mm256_andnot_pd(sign,
+				_mm256_sub_pd(_mm256_loadu_pd(x + i),
+						_mm256_loadu_pd(x + i - 1)));
+		unord = _mm256_or_pd(unord, _mm256_cmp_pd(d, d, _CMP_UNORD_Q));
+		m = _mm256_max_pd(m, d);
+		s = _mm256_add_pd(s,
+				_mm256_mul_pd(d,
+						_mm256_mul_pd(w,
+								_mm256_permute4x64_pd(
+										_mm256_loadu_pd(g + n - 4 - i),
+										0x1B))));
+	}
+
+	_mm256_storeu_pd(mv, m);
+	_mm256_storeu_pd(sv, s);
+	for (j = 0; j < 4; j++) {
+		if (mv[j] > r)
+			r = mv[j];
+		wsum += sv[j];
+	}
+	if (_mm256_movemask_pd(unord))
+		r = NAN;
+
+	af_block_summary_part(x, n, lastval, g, i, n, r, wsum);
+	return r;
+}
+
+#endif
+
+static double (*af_block_summary_func)(const double *, int, double,
+		const double *, double &) = NULL;
+
+double af_block_summary(const double *x, int n, double lastval, const double *g,
+		double &wsum) {
+
+	if (af_block_summary_func == NULL) {
+		af_block_summary_func = &af_block_summary_scalar;
+#ifdef AF_ENGINE_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			af_block_summary_func = &af_block_summary_avx2;
+#endif
+	}
+
+	return (*af_block_summary_func)(x, n, lastval, g, wsum);
+}
+
+bool af_block_skip(const double *x, int n, double &lastval, float &diffavg,
+		double multiplicator, const double *decay, const double *g) {
+
+	double m, wsum;
+
+	// same limits of the proof as af_block_quiet
+	if (n <= 0 || !(diffavg >= AF_BLOCK_MIN_DIFFAVG)
+			|| diffavg * decay[n - 1] < AF_BLOCK_MIN_DIFFAVG)
+		return false;
+
+	m = af_block_summary(x, n, lastval, g, wsum);
+	if (!(m < multiplicator * diffavg * decay[n - 1]))
+		return false;
+
+	diffavg = g[n] * diffavg + wsum;
+	lastval = x[n - 1];
+	return true;
+}
+
+// selected implementation
+static int (*af_engine_func)(af_engine &, const double *, double, int) = NULL;
+static const char *af_engine_func_name = "scalar";
+
+static void af_engine_select() {
+	af_engine_func = &af_engine_tick_scalar;
+#ifdef AF_ENGINE_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		af_engine_func = &af_engine_tick_avx2;
+		af_engine_func_name = "avx2";
+	}
+#endif
+}
+
+const char *af_engine_name() {
+	if (af_engine_func == NULL)
+		af_engine_select();
+	return af_engine_func_name;
+}
+
+int af_engine_tick(af_engine &e, const double *cur, double multiplicator,
+		int n_amend) {
+	if (af_engine_func == NULL)
+		af_engine_select();
+	return (*af_engine_func)(e, cur, multiplicator, n_amend);
+}
@@ -0,0 +1,87 @@
+/*
+ * af_engine.hpp
+ *
+ * Multi channel detector engine: detector state of all channels kept
+ * as aligned per-field arrays (struct of arrays). One pass per timestamp
+ * updates noise level of all quiet channels (AVX2 when available), only
+ * channels crossing the alarm threshold or in alarm/pattern state
+ * are handed to scalar processing
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_ENGINE_HPP_
+#define AF_ENGINE_HPP_
+
+#include <stdint.h>
+
+#include "af_ring.hpp"
+
+// state of channels, item c of each array belongs to channel c
+struct af_engine {
+	int n;						// number of channels
+	double *lastval;			// last value
+	float *diffavg;				// average difference (noise level)
+	int32_t *busy;				// != 0 if channel needs scalar processing
+	int32_t *isalarm;
+	int32_t *iswait;
+	int32_t *numthresholded;
+	int32_t *patternid;
+	int32_t *ispattern;			// number of patterns being collected
+	af_window *windows;			// windows[c * nwin ...] patterns being collected
+	int nwin;
+	int32_t *genpattern_count;
+	long long *alarmraisetime;
+	long long *genpattern_time;
+	int *scalar;				// channels for scalar processing found by the last pass
+};
+
+// allocates state of n channels (all zero, busy), up to nwin patterns
+// collected concurrently in each channel
+void af_engine_init(af_engine &e, int n, int nwin);
+void af_engine_free(af_engine &e);
+
+// one timestamp: cur[c] is the current value of channel c
+// for channels not busy and with |cur - lastval| < multiplicator * diffavg,
+// diffavg is amended by smoothing constant n_amend and lastval is set
+// (same arithmetic as the scalar detector), other channels are written
+// to e.scalar in increasing order, returns their number
+int af_engine_tick(af_engine &e, const double *cur, double multiplicator,
+		int n_amend);
+
+// name of selected implementation ("avx2" or "scalar")
+const char *af_engine_name();
+
+// single channel, block of values (block mode of the detector)
+
+// decay[i] = lower bound of diffavg after i quiet values relative to its start value,
+// i.e. ((n_amend - 1) / n_amend)^i reduced by a margin covering float rounding
+void af_block_decay(double *decay, int n, int n_amend);
+
+// number of leading values of x[0..n) (following lastval) proven not to cross
+// multiplicator * diffavg, diffavg starting at given value and decaying at most by decay
+int af_block_quiet(const double *x, int n, double lastval, float diffavg,
+		double multiplicator, const double *decay);
+
+// amends lastval and diffavg by quiet values x[0..n) exactly as the scalar detector
+void af_block_amend(const double *x, int n, double &lastval, float &diffavg,
+		int n_amend);
+
+// quiet skip-scan of whole blocks (aggregated noise level update)
+
+// g[k] = r^k for k = 0..n, r = (n_amend - 1) / n_amend (weights of the aggregated update)
+void af_block_weights(double *g, int n, int n_amend);
+
+// summary of values x[0..n) (following lastval): returns max |diff|,
+// wsum = sum of (1 - r) * r^(n - 1 - i) * |diff_i| (g from af_block_weights)
+double af_block_summary(const double *x, int n, double lastval, const double *g,
+		double &wsum);
+
+// if max |diff| of x[0..n) is proven below multiplicator * diffavg decayed over
+// the whole block, lastval and diffavg are amended by the aggregated update
+// diffavg = r^n * diffavg + wsum (equal to the record by record update up to rounding)
+// and true is returned, otherwise nothing is changed
+bool af_block_skip(const double *x, int n, double &lastval, float &diffavg,
+		double multiplicator, const double *decay, const double *g);
+
+#endif /* AF_ENGINE_HPP_ */
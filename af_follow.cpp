@@ -0,0 +1,177 @@
+/*
+ * af_follow.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include "af_follow.hpp"
+
+// set by af_follow_stop()
+static volatile sig_atomic_t af_follow_stopped = 0;
+
+// events of followed file and of its directory waking up the reader
+#define AF_FOLLOW_FILE_EVENTS (IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF)
+#define AF_FOLLOW_DIR_EVENTS (IN_CREATE | IN_MOVED_TO)
+
+long long af_now_usec() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void af_follow_stop() {
+	af_follow_stopped = 1;
+}
+
+// opens file fn for following, returns 0 if ok
+int af_follow_open(af_follow &f, const std::string &fn, bool from_end) {
+
+	struct stat st;
+	std::string dir;
+	size_t slash;
+
+	f.fn = fn;
+	f.in = f.wfile = f.wdir = -1;
+	f.lastc = '\n';
+	f.readtime = af_now_usec();
+	f.rotations = f.truncations = 0;
+
+	f.fd = open(fn.c_str(), O_RDONLY);
+	if (f.fd < 0)
+		return 1;
+	if (fstat(f.fd, &st) != 0) {
+		close(f.fd);
+		f.fd = -1;
+		return 1;
+	}
+	f.dev = st.st_dev;
+	f.ino = st.st_ino;
+
+	f.offset = 0;
+	if (from_end)
+		f.offset = lseek(f.fd, 0, SEEK_END);
+
+	// without inotify the file is polled each AF_FOLLOW_POLL_MS
+	f.in = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (f.in >= 0) {
+		f.wfile = inotify_add_watch(f.in, fn.c_str(), AF_FOLLOW_FILE_EVENTS);
+		slash = fn.rfind('/');
+		dir = slash == std::string::npos ? "." : fn.substr(0, slash + 1);
+		f.wdir = inotify_add_watch(f.in, dir.c_str(), AF_FOLLOW_DIR_EVENTS);
+	}
+
+	return 0;
+}
+
+void af_follow_close(af_follow &f) {
+	if (f.in >= 0)
+		close(f.in);
+	if (f.fd >= 0)
+		close(f.fd);
+	f.in = f.fd = -1;
+}
+
+// checks state of followed file when no more data can be read
+// returns 1 if reading should continue (new data, truncated or rotated file)
+static int af_follow_check(af_follow &f) {
+
+	struct stat st;
+	int fd;
+
+	if (fstat(f.fd, &st) == 0) {
+		// data appended meanwhile
+		if (st.st_size > f.offset)
+			return 1;
+
+		// same file truncated (e.g. copytruncate rotation), read from start
+		if (st.st_size < f.offset) {
+			lseek(f.fd, 0, SEEK_SET);
+			f.offset = 0;
+			f.truncations++;
+			return 1;
+		}
+	}
+
+	// other file of the same name (rotation), old file read up to its end
+	if (stat(f.fn.c_str(), &st) != 0
+			|| (st.st_dev == f.dev && st.st_ino == f.ino))
+		return 0;
+
+	// new file may not be readable yet, retried at next wake up
+	fd = open(f.fn.c_str(), O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		if (fd >= 0)
+			close(fd);
+		return 0;
+	}
+
+	close(f.fd);
+	f.fd = fd;
+	f.dev = st.st_dev;
+	f.ino = st.st_ino;
+	f.offset = 0;
+	f.rotations++;
+
+	if (f.in >= 0) {
+		if (f.wfile >= 0)
+			inotify_rm_watch(f.in, f.wfile);	// may be removed already
+		f.wfile = inotify_add_watch(f.in, f.fn.c_str(), AF_FOLLOW_FILE_EVENTS);
+	}
+
+	return 1;
+}
+
+// reads data appended to followed file, blocks until they arrive
+long af_follow_read(void *ctx, char *dst, size_t cap) {
+
+	af_follow &f = *(af_follow *) ctx;
+	struct pollfd pfd;
+	char events[4096];
+	long got;
+
+	for (;;) {
+		if (af_follow_stopped)
+			return 0;
+
+		got = read(f.fd, dst, cap);
+		if (got > 0) {
+			f.offset += got;
+			f.lastc = dst[got - 1];
+			f.readtime = af_now_usec();
+			return got;
+		}
+		if (got < 0 && errno != EINTR)
+			return got;
+		if (got < 0)
+			continue;
+
+		if (af_follow_check(f)) {
+			// unfinished last line of rotated or truncated data ends here
+			if (f.lastc != '\n') {
+				dst[0] = '\n';
+				f.lastc = '\n';
+				return 1;
+			}
+			continue;
+		}
+
+		// wait for event (interrupted by signal, e.g. stop request),
+		// events are only drained, file state is checked above
+		pfd.fd = f.in;
+		pfd.events = POLLIN;
+		if (poll(&pfd, f.in >= 0 ? 1 : 0, AF_FOLLOW_POLL_MS) > 0)
+			while (read(f.in, events, sizeof(events)) > 0)
+				;
+	}
+}
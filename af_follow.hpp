@@ -0,0 +1,50 @@
+/*
+ * af_follow.hpp
+ *
+ * Follow mode input: reads data appended to a growing file as they arrive
+ * (woken by inotify events), survives file rotation and truncation
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_FOLLOW_HPP_
+#define AF_FOLLOW_HPP_
+
+#include <string>
+#include <sys/types.h>
+
+// longest wait for inotify event, bounds detection of rotation and of stop request
+#define AF_FOLLOW_POLL_MS 1000
+
+// followed file
+struct af_follow {
+	std::string fn;		// followed file name
+	int fd;				// currently read file
+	dev_t dev;			// identity of currently read file
+	ino_t ino;
+	off_t offset;		// bytes read from currently read file
+	char lastc;			// last byte read (line end check at rotation)
+	int in;				// inotify descriptor
+	int wfile;			// watch of the file
+	int wdir;			// watch of its directory (new file after rotation)
+	long long readtime;	// wall clock (usec) when the last data were read
+	unsigned long rotations;	// number of reopenings after rotation
+	unsigned long truncations;	// number of restarts after truncation
+};
+
+// opens file fn for following, from its start or from its end
+// returns 0 if ok
+int af_follow_open(af_follow &f, const std::string &fn, bool from_end);
+void af_follow_close(af_follow &f);
+
+// source for af_text_open_source, ctx points to af_follow
+// blocks until new data arrive, returns 0 only after af_follow_stop()
+long af_follow_read(void *ctx, char *dst, size_t cap);
+
+// requests end of following (async signal safe, e.g. from SIGINT handler)
+void af_follow_stop();
+
+// wall clock in microseconds
+long long af_now_usec();
+
+#endif /* AF_FOLLOW_HPP_ */
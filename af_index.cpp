@@ -0,0 +1,141 @@
+/*
+ * af_index.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "af_index.hpp"
+#include "af_input.hpp"
+#include "af_parse.hpp"
+
+std::string af_index_name(const std::string &fn) {
+	return fn + AF_INDEX_SUFFIX;
+}
+
+// header describing current state of file fn, returns 0 if ok
+static int af_index_source(const std::string &fn, af_index_header &h) {
+
+	struct stat st;
+
+	if (stat(fn.c_str(), &st) != 0)
+		return 1;
+
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, AF_INDEX_MAGIC, 4);
+	h.version = AF_INDEX_VERSION;
+	h.source_size = st.st_size;
+	h.source_mtime = st.st_mtime;
+
+	return 0;
+}
+
+long af_index_create(const std::string &fn, const char *data, size_t n,
+		long long interval) {
+
+	af_index_header h;
+	af_index_entry en;
+	std::vector<af_index_entry> idx;
+	af_text_reader r;
+	af_time_cache tc;
+	af_span line, ts;
+	const char *semi;
+	long long usec;
+	long long next = 0;
+	FILE *f;
+	int err;
+
+	if (interval < 1 || af_index_source(fn, h))
+		return -1;
+	h.interval = interval;
+
+	// lines of the file, only timestamps parsed
+	af_time_cache_reset(tc);
+	af_text_open_memory(r, data, n);
+	while (af_text_next_line(r, line, semi)) {
+		if (semi == NULL)
+			continue;
+		ts.b = line.b;
+		ts.n = semi - line.b;
+		if (!af_parse_timestamp(af_trim(ts), tc, usec) || usec < next)
+			continue;
+
+		en.usec = usec;
+		en.offset = line.b - data;
+		idx.push_back(en);
+
+		// start of the next interval
+		next = usec - usec % interval + interval;
+	}
+	af_text_close(r);
+
+	h.count = idx.size();
+
+	f = fopen(af_index_name(fn).c_str(), "wb");
+	if (f == NULL)
+		return -1;
+	err = fwrite(&h, sizeof(h), 1, f) != 1
+			|| (h.count
+					&& fwrite(&idx[0], sizeof(af_index_entry), h.count, f)
+							!= h.count);
+	if (fclose(f) != 0 || err)
+		return -1;
+
+	return h.count;
+}
+
+int af_index_load(const std::string &fn, std::vector<af_index_entry> &idx) {
+
+	af_index_header h, cur;
+	FILE *f;
+	int err;
+
+	idx.clear();
+
+	if (af_index_source(fn, cur))
+		return 1;
+
+	f = fopen(af_index_name(fn).c_str(), "rb");
+	if (f == NULL)
+		return 1;
+
+	err = fread(&h, sizeof(h), 1, f) != 1
+			|| memcmp(h.magic, AF_INDEX_MAGIC, 4) != 0
+			|| h.version != AF_INDEX_VERSION
+			|| h.source_size != cur.source_size
+			|| h.source_mtime != cur.source_mtime;
+	if (!err && h.count) {
+		idx.resize(h.count);
+		err = fread(&idx[0], sizeof(af_index_entry), h.count, f) != h.count;
+	}
+	fclose(f);
+
+	if (err) {
+		idx.clear();
+		return 1;
+	}
+
+	return 0;
+}
+
+uint64_t af_index_seek(const std::vector<af_index_entry> &idx, long long usec) {
+
+	size_t lo = 0;
+	size_t hi = idx.size();
+	size_t mid;
+
+	// first entry with timestamp > usec
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (idx[mid].usec <= usec)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo == 0 ? 0 : idx[lo - 1].offset;
+}
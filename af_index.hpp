@@ -0,0 +1,56 @@
+/*
+ * af_index.hpp
+ *
+ * Timestamp index of text input file (sidecar file <input>.afx):
+ * byte offsets of the first lines of each interval of timestamps,
+ * used to start processing of a time range without reading the file from its start
+ *
+ * File layout (little endian):
+ *   header (af_index_header, 48 bytes)
+ *   entries (af_index_entry) in increasing order of timestamps
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_INDEX_HPP_
+#define AF_INDEX_HPP_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#define AF_INDEX_MAGIC "AFXI"
+#define AF_INDEX_VERSION 1
+#define AF_INDEX_SUFFIX ".afx"
+
+struct af_index_header {
+	char magic[4];			// AF_INDEX_MAGIC
+	uint32_t version;		// AF_INDEX_VERSION
+	int64_t interval;		// interval of entries, microseconds
+	uint64_t source_size;	// size of indexed file (index valid only for the same
+	int64_t source_mtime;	// size and modification time)
+	uint64_t count;			// number of entries
+	uint64_t reserved;
+};
+
+struct af_index_entry {
+	int64_t usec;		// timestamp of the line
+	uint64_t offset;	// byte offset of the line in the file
+};
+
+// name of index file of file fn
+std::string af_index_name(const std::string &fn);
+
+// builds index of text file fn (data[0..n) is its content), an entry for the first
+// line of each interval (microseconds) of timestamps, writes index file
+// returns number of entries, -1 on error
+long af_index_create(const std::string &fn, const char *data, size_t n,
+		long long interval);
+
+// loads index of file fn, returns 0 if ok (missing, other or changed file: 1)
+int af_index_load(const std::string &fn, std::vector<af_index_entry> &idx);
+
+// offset of the last indexed line with timestamp <= usec (0 if none)
+uint64_t af_index_seek(const std::vector<af_index_entry> &idx, long long usec);
+
+#endif /* AF_INDEX_HPP_ */
@@ -0,0 +1,268 @@
+/*
+ * af_input.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "af_input.hpp"
+#include "af_scan.hpp"
+
+// maps file fn, returns 0 if ok
+int af_mmap_open(af_mmap_file &f, const std::string &fn) {
+
+	struct stat st;
+	long pagesize;
+	void *base;
+	int fd;
+
+	f.data = NULL;
+	f.size = 0;
+	f.maplen = 0;
+
+	fd = open(fn.c_str(), O_RDONLY);
+	if (fd < 0)
+		return 1;
+
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return 1;
+	}
+
+	// reserve anonymous (zeroed) area one byte longer than the file
+	// and map the file over its beginning
+	pagesize = sysconf(_SC_PAGESIZE);
+	f.size = st.st_size;
+	f.maplen = ((f.size + 1 + pagesize - 1) / pagesize) * pagesize;
+
+	base = mmap(NULL, f.maplen, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+			0);
+	if (base == MAP_FAILED) {
+		close(fd);
+		return 1;
+	}
+
+	if (f.size > 0
+			&& mmap(base, f.size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0)
+					== MAP_FAILED) {
+		munmap(base, f.maplen);
+		close(fd);
+		return 1;
+	}
+
+	// mapping stays valid after close
+	close(fd);
+
+	madvise(base, f.maplen, MADV_SEQUENTIAL);
+	f.data = (char *) base;
+
+	return 0;
+}
+
+void af_mmap_close(af_mmap_file &f) {
+	if (f.data != NULL)
+		munmap(f.data, f.maplen);
+	f.data = NULL;
+	f.size = 0;
+	f.maplen = 0;
+}
+
+// reads file descriptor, ctx points to int fd
+long af_fd_read(void *ctx, char *dst, size_t cap) {
+	long got;
+
+	do
+		got = read(*(int *) ctx, dst, cap);
+	while (got < 0 && errno == EINTR);
+
+	return got;
+}
+
+// common part of opening
+static void af_text_init(af_text_reader &r) {
+	r.p = r.e = r.se = r.ib = NULL;
+	r.semi = NULL;
+	r.idx = new uint32_t[AF_SCAN_CHUNK];
+	r.idxn = r.idxi = 0;
+	r.read = NULL;
+	r.ctx = NULL;
+	r.fd = -1;
+	r.buf = NULL;
+	r.bufsize = 0;
+	r.eof = true;
+}
+
+// reader of data in memory
+void af_text_open_memory(af_text_reader &r, const char *data, size_t n) {
+	af_text_init(r);
+	r.p = r.se = data;
+	r.e = data + n;
+}
+
+// reader of data from source
+void af_text_open_source(af_text_reader &r, af_read_func read, void *ctx) {
+	af_text_init(r);
+	r.read = read;
+	r.ctx = ctx;
+	r.bufsize = AF_TEXT_BUFFER;
+	r.buf = new char[r.bufsize];
+	r.p = r.e = r.se = r.buf;
+	r.eof = false;
+}
+
+// reader of file descriptor
+void af_text_open_fd(af_text_reader &r, int fd) {
+	af_text_open_source(r, &af_fd_read, NULL);
+	r.fd = fd;
+	r.ctx = &r.fd;
+}
+
+// data already read from source, before the first line is read
+void af_text_preload(af_text_reader &r, const char *data, size_t n) {
+	if (n > r.bufsize - (r.e - r.buf))
+		n = r.bufsize - (r.e - r.buf);
+	memcpy((char *) r.e, data, n);
+	r.e += n;
+}
+
+void af_text_close(af_text_reader &r) {
+	delete[] r.idx;
+	delete[] r.buf;
+	r.idx = NULL;
+	r.buf = NULL;
+	r.p = r.e = r.se = r.ib = NULL;
+	r.idxn = r.idxi = 0;
+}
+
+// moves unfinished line to the start of buffer and reads more data from source
+// called only when all data in buffer are scanned, returns false if no more data
+static bool af_text_fill(af_text_reader &r) {
+
+	size_t keep;
+	char *nb;
+	long got;
+
+	if (r.read == NULL || r.eof)
+		return false;
+
+	// unfinished line, buffer grows if the line is too long
+	keep = r.e - r.p;
+	nb = r.buf;
+	if (keep > r.bufsize / 2) {
+		r.bufsize *= 2;
+		nb = new char[r.bufsize];
+	}
+	memmove(nb, r.p, keep);
+	if (r.semi != NULL)
+		r.semi = nb + (r.semi - r.p);
+	if (nb != r.buf) {
+		delete[] r.buf;
+		r.buf = nb;
+	}
+	r.p = r.buf;
+	r.e = r.se = r.buf + keep;
+	r.idxn = r.idxi = 0;
+
+	got = (*r.read)(r.ctx, r.buf + keep, r.bufsize - keep);
+	if (got <= 0) {
+		r.eof = true;
+		return false;
+	}
+	r.e += got;
+
+	return true;
+}
+
+// returns next line (without '\n'), semi is its first ';' or NULL
+bool af_text_next_line(af_text_reader &r, af_span &line, const char *&semi) {
+
+	const char *q;
+	size_t chunk;
+
+	for (;;) {
+		// walk structural index up to the next '\n'
+		while (r.idxi < r.idxn) {
+			q = r.ib + r.idx[r.idxi++];
+			if (*q == ';') {
+				if (r.semi == NULL)
+					r.semi = q;
+				continue;
+			}
+			line.b = r.p;
+			line.n = q - r.p;
+			semi = r.semi;
+			r.p = q + 1;
+			r.semi = NULL;
+			return true;
+		}
+
+		// index of the next chunk
+		if (r.se < r.e) {
+			chunk = r.e - r.se;
+			if (chunk > AF_SCAN_CHUNK)
+				chunk = AF_SCAN_CHUNK;
+			r.ib = r.se;
+			r.idxn = af_scan(r.ib, chunk, r.idx);
+			r.idxi = 0;
+			r.se += chunk;
+			continue;
+		}
+
+		// more data from source
+		if (af_text_fill(r))
+			continue;
+
+		// last line without '\n'
+		if (r.p < r.e) {
+			line.b = r.p;
+			line.n = r.e - r.p;
+			semi = r.semi;
+			r.p = r.e;
+			r.semi = NULL;
+			return true;
+		}
+
+		return false;
+	}
+}
+
+// trim spaces from both sides (same as trim() for strings)
+af_span af_trim(af_span s) {
+	while (s.n > 0 && s.b[0] == ' ') {
+		s.b++;
+		s.n--;
+	}
+	while (s.n > 0 && s.b[s.n - 1] == ' ')
+		s.n--;
+	return s;
+}
+
+// true if span contains string what (empty what is always contained)
+bool af_span_contains(af_span s, const std::string &what) {
+
+	const char *p;
+	const char *e;
+
+	if (what.empty())
+		return true;
+	if (what.size() > s.n)
+		return false;
+
+	e = s.b + s.n - what.size();
+	for (p = s.b; p <= e; p++) {
+		p = (const char *) memchr(p, what[0], e - p + 1);
+		if (p == NULL)
+			return false;
+		if (memcmp(p, what.data(), what.size()) == 0)
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,84 @@
+/*
+ * af_input.hpp
+ *
+ * Input helpers for alarm_fingerprints: memory mapped input file,
+ * text reader based on structural index and in place parsing of measurement lines
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_INPUT_HPP_
+#define AF_INPUT_HPP_
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+// initial size of text reader buffer for data read from source
+#define AF_TEXT_BUFFER (1024 * 1024)
+
+// span of characters inside of an input buffer (not copied, not 0 terminated)
+struct af_span {
+	const char *b;	// first char
+	size_t n;		// number of chars
+};
+
+// memory mapped input file
+// mapping is one byte longer than the file and the extra byte is always 0
+struct af_mmap_file {
+	char *data;		// start of mapped file
+	size_t size;	// size of file (without the trailing 0)
+	size_t maplen;	// length of the whole mapping
+};
+
+// maps file fn, returns 0 if ok
+int af_mmap_open(af_mmap_file &f, const std::string &fn);
+void af_mmap_close(af_mmap_file &f);
+
+// source of data for text reader: reads at most cap bytes to dst
+// returns number of bytes read, 0 at the end of data, < 0 on error
+typedef long (*af_read_func)(void *ctx, char *dst, size_t cap);
+
+// reads file descriptor, ctx points to int fd
+long af_fd_read(void *ctx, char *dst, size_t cap);
+
+// text reader: lines and ';' positions are taken from structural index
+// (see af_scan.hpp) built for chunks of data, lines are never copied
+// (data from source are only moved to the start of buffer when it is refilled)
+struct af_text_reader {
+	const char *p;		// start of the next line
+	const char *e;		// end of data
+	const char *se;		// end of scanned data
+	const char *ib;		// base of structural index
+	const char *semi;	// first ';' of the line in progress, NULL if none
+	uint32_t *idx;		// structural index of the last scanned chunk (offsets from ib)
+	size_t idxn;		// number of index items
+	size_t idxi;		// next index item
+	af_read_func read;	// data source, NULL if all data are in memory
+	void *ctx;			// context of data source
+	int fd;				// file descriptor (af_text_open_fd)
+	char *buf;			// buffer for data from source
+	size_t bufsize;
+	bool eof;			// no more data from source
+};
+
+// reader of data in memory (e.g. memory mapped file)
+void af_text_open_memory(af_text_reader &r, const char *data, size_t n);
+// reader of data from source
+void af_text_open_source(af_text_reader &r, af_read_func read, void *ctx);
+// reader of file descriptor (e.g. 0 for stdin)
+void af_text_open_fd(af_text_reader &r, int fd);
+// puts data already read from source (e.g. to recognize format) before its next data
+// (only before the first line is read)
+void af_text_preload(af_text_reader &r, const char *data, size_t n);
+void af_text_close(af_text_reader &r);
+
+// returns next line (without '\n', same lines as std::getline would return),
+// semi is its first ';' or NULL; false at the end of data
+bool af_text_next_line(af_text_reader &r, af_span &line, const char *&semi);
+
+// span helpers
+af_span af_trim(af_span s);
+bool af_span_contains(af_span s, const std::string &what);
+
+#endif /* AF_INPUT_HPP_ */
@@ -0,0 +1,415 @@
+/*
+ * af_lift.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "af_lift.hpp"
+
+// terms of the last detail polynomial smaller than this relative to the
+// largest one are rounding residues of the factorization
+#define AF_LIFT_RESIDUE 1e-12
+
+// Laurent polynomial sum c[k] * z^(lo + k), z^s standing for the value s
+// places further
+struct af_lpoly {
+	int lo;
+	std::vector<double> c;
+};
+
+static inline int af_lpoly_hi(const af_lpoly &p) {
+	return p.lo + (int) p.c.size() - 1;
+}
+
+// zero terms at both ends removed
+static void af_lpoly_trim(af_lpoly &p) {
+
+	size_t b = 0, e = p.c.size();
+
+	while (e > 0 && p.c[e - 1] == 0)
+		e--;
+	while (b < e && p.c[b] == 0)
+		b++;
+	p.c.erase(p.c.begin() + e, p.c.end());
+	p.c.erase(p.c.begin(), p.c.begin() + b);
+	p.lo = p.c.empty() ? 0 : p.lo + (int) b;
+}
+
+// p -= f * z^s * q, p extended as needed (not trimmed)
+static void af_lpoly_sub(af_lpoly &p, double f, int s, const af_lpoly &q) {
+
+	int lo, hi;
+	size_t k;
+
+	if (q.c.empty())
+		return;
+	if (p.c.empty()) {
+		p.lo = q.lo + s;
+		p.c.assign(q.c.size(), 0.0);
+	}
+	lo = q.lo + s < p.lo ? q.lo + s : p.lo;
+	hi = af_lpoly_hi(q) + s > af_lpoly_hi(p) ? af_lpoly_hi(q) + s : af_lpoly_hi(p);
+	p.c.insert(p.c.begin(), p.lo - lo, 0.0);
+	p.c.resize(hi - lo + 1, 0.0);
+	p.lo = lo;
+	for (k = 0; k < q.c.size(); k++)
+		p.c[q.lo + s + k - lo] -= f * q.c[k];
+}
+
+// p -= q * r
+static void af_lpoly_sub_mul(af_lpoly &p, const af_lpoly &q, const af_lpoly &r) {
+
+	size_t k;
+
+	for (k = 0; k < q.c.size(); k++)
+		af_lpoly_sub(p, q.c[k], q.lo + (int) k, r);
+	af_lpoly_trim(p);
+}
+
+// a = q * b + r, len(r) < len(b) <= len(a): the first ntop terms of q cancel
+// the highest terms of a, the others the lowest ones
+static void af_lpoly_div(const af_lpoly &a, const af_lpoly &b, int ntop,
+		af_lpoly &q, af_lpoly &r) {
+
+	int nq = (int) a.c.size() - (int) b.c.size() + 1;
+	int t, pos, s;
+	double f;
+
+	q.lo = 0;
+	q.c.clear();
+	r = a;
+	for (t = 0; t < nq; t++) {
+		if (t < ntop) {
+			pos = af_lpoly_hi(a) - t;
+			s = pos - af_lpoly_hi(b);
+			f = r.c[pos - r.lo] / b.c.back();
+		} else {
+			pos = a.lo + t - ntop;
+			s = pos - b.lo;
+			f = r.c[pos - r.lo] / b.c[0];
+		}
+		af_lpoly_sub(q, -f, s, af_lpoly { 0, std::vector<double>(1, 1.0) });
+		af_lpoly_sub(r, f, s, b);
+		r.c[pos - r.lo] = 0;	// exactly cancelled
+	}
+	af_lpoly_trim(q);
+	af_lpoly_trim(r);
+}
+
+static double af_lpoly_max(const af_lpoly &p) {
+
+	double m = 0;
+	size_t k;
+
+	for (k = 0; k < p.c.size(); k++)
+		if (fabs(p.c[k]) > m)
+			m = fabs(p.c[k]);
+	return m;
+}
+
+// step of lifting polynomial q; columns of the polynomial matrix updated so
+// that it times the step stays the same (the approximation row by the caller)
+static void af_lift_add(af_lift &l, bool odd, const af_lpoly &q, af_lpoly &de,
+		af_lpoly &dO) {
+
+	af_lift_step st;
+
+	st.odd = odd;
+	st.lo = q.lo;
+	st.q = q.c;
+	l.steps.push_back(st);
+	if (odd)
+		af_lpoly_sub_mul(de, q, dO);
+	else
+		af_lpoly_sub_mul(dO, q, de);
+}
+
+// growth of values by a step (or the scaling), rounding errors of the
+// transform grow about as the product of these
+static double af_lift_growth(const af_lpoly &q) {
+
+	double g = 0;
+	size_t k;
+
+	for (k = 0; k < q.c.size(); k++)
+		g += fabs(q.c[k]);
+	return log(1 + g);
+}
+
+// all sequences of divisions of (ce, co) to a single term (the quotient
+// aligned to any end, either row divided when of the same length) searched
+// for the smallest total growth; choices as nt (odd row updated) or -nt - 1
+static void af_lift_search(const af_lpoly &ce, const af_lpoly &co, double g,
+		std::vector<int> &path, std::vector<int> &best, double &cost) {
+
+	af_lpoly q, r;
+	int nt, nq, d;
+
+	if (g >= cost)
+		return;
+	if (ce.c.empty() || co.c.empty()) {
+		// the remaining term is the approximation scaling
+		q = ce.c.empty() ? co : ce;
+		if (q.c.size() != 1)
+			return;
+		g += fabs(log(fabs(q.c[0])));
+		if (g < cost) {
+			cost = g;
+			best = path;
+		}
+		return;
+	}
+	for (d = 0; d < 2; d++) {
+		const af_lpoly &a = d == 0 ? ce : co;
+		const af_lpoly &b = d == 0 ? co : ce;
+		if (a.c.size() < b.c.size())
+			continue;
+		nq = (int) a.c.size() - (int) b.c.size() + 1;
+		for (nt = 0; nt <= nq; nt++) {
+			af_lpoly_div(a, b, nt, q, r);
+			path.push_back(d == 0 ? nt : -nt - 1);
+			if (d == 0)
+				af_lift_search(r, co, g + af_lift_growth(q), path, best, cost);
+			else
+				af_lift_search(ce, r, g + af_lift_growth(q), path, best, cost);
+			path.pop_back();
+		}
+	}
+}
+
+int af_lift_init(af_lift &l, int family) {
+
+	const double *c = af_daub_coefficients(family);
+	af_lpoly ce, co, de, dO, q, r;
+	std::vector<int> path, best;
+	int h = family / 2;
+	int k, nt, le, re, lo, ro, n;
+	bool odd;
+	size_t j;
+	double m, cost = HUGE_VAL;
+
+	if (c == NULL)
+		return 1;
+
+	// rows of the polyphase matrix: approximation and detail filters,
+	// detail d_k = (-1)^k c[P - 1 - k]
+	ce.lo = co.lo = de.lo = dO.lo = 0;
+	for (k = 0; k < h; k++) {
+		ce.c.push_back(c[2 * k]);
+		co.c.push_back(c[2 * k + 1]);
+		de.c.push_back(c[family - 1 - 2 * k]);
+		dO.c.push_back(-c[family - 2 - 2 * k]);
+	}
+
+	// Euclidean algorithm on the approximation row along the best sequence of
+	// divisions (af_lift_search)
+	l.family = family;
+	l.steps.clear();
+	path.clear();
+	af_lift_search(ce, co, 0, path, best, cost);
+	for (j = 0; j < best.size(); j++) {
+		odd = best[j] >= 0;
+		nt = odd ? best[j] : -best[j] - 1;
+		af_lpoly_div(odd ? ce : co, odd ? co : ce, nt, q, r);
+		// remainder with the cancelled terms exactly zero
+		af_lift_add(l, odd, q, de, dO);
+		*(odd ? &ce : &co) = r;
+	}
+	if (ce.c.empty()) {
+		// approximation row (0, co): columns swapped by two more steps,
+		// even += odd and odd -= even
+		af_lift_add(l, true, af_lpoly { 0, std::vector<double>(1, -1.0) },
+				de, dO);
+		ce = co;
+		af_lift_add(l, false, af_lpoly { 0, std::vector<double>(1, 1.0) },
+				de, dO);
+		co.c.clear();
+	}
+	if (ce.c.size() != 1)
+		return 1;
+
+	// the rest is diagonal up to the even part of the detail (the odd one
+	// is a monomial but for rounding residues)
+	l.ka = ce.c[0];
+	l.sa = ce.lo;
+	j = 0;
+	for (k = 1; k < (int) dO.c.size(); k++)
+		if (fabs(dO.c[k]) > fabs(dO.c[j]))
+			j = k;
+	l.kb = dO.c[j];
+	l.sb = dO.lo + (int) j;
+	m = af_lpoly_max(de);
+	for (j = 0; j < de.c.size(); j++)
+		if (fabs(de.c[j]) <= AF_LIFT_RESIDUE * m)
+			de.c[j] = 0;
+	af_lpoly_trim(de);
+	l.ulo = de.lo;
+	l.u = de.c;
+
+	// values needed before (le, lo) and behind (re, ro) the level for
+	// outputs 0 .. h - 1, from the last step to the first one
+	n = (int) l.u.size();
+	le = std::max(0, std::max(-l.sa, n ? -l.ulo : 0));
+	re = std::max(0, std::max(l.sa, n ? l.ulo + n - 1 : 0));
+	lo = std::max(0, -l.sb);
+	ro = std::max(0, l.sb);
+	for (k = (int) l.steps.size() - 1; k >= 0; k--) {
+		const af_lift_step &st = l.steps[k];
+		n = (int) st.q.size();
+		if (st.odd) {
+			le = std::max(le, lo - st.lo);
+			re = std::max(re, ro + st.lo + n - 1);
+		} else {
+			lo = std::max(lo, le - st.lo);
+			ro = std::max(ro, re + st.lo + n - 1);
+		}
+	}
+	l.margin = std::max(std::max(le, re), std::max(lo, ro));
+
+	return 0;
+}
+
+// dst_i += sum q[k] * src_(i + lo + k) for i in [from, to)
+static inline void af_lift_apply(double *dst, const double *src,
+		const af_lift_step &st, int from, int to) {
+
+	const double *q = &st.q[0];
+	int n = (int) st.q.size();
+	int i, k;
+	double v;
+
+	src += st.lo;
+	if (n == 2) {
+		for (i = from; i < to; i++)
+			dst[i] += q[0] * src[i] + q[1] * src[i + 1];
+	} else if (n == 1) {
+		for (i = from; i < to; i++)
+			dst[i] += q[0] * src[i];
+	} else {
+		for (i = from; i < to; i++) {
+			v = 0;
+			for (k = 0; k < n; k++)
+				v += q[k] * src[i + k];
+			dst[i] += v;
+		}
+	}
+}
+
+void af_lift_transform(af_lift &l, int n, const double x[], double y[]) {
+
+	const int minm = l.family == 2 ? 2 : 4;
+	const int mg = l.margin;
+	const double *u = l.u.empty() ? NULL : &l.u[0];
+	int nu = (int) l.u.size();
+	int i, k, m, h, t;
+	int elo, ehi, olo, ohi, from, to;
+	double *e, *o;
+	double b;
+	size_t s;
+
+	if (y != x)
+		for (i = 0; i < n; i++)
+			y[i] = x[i];
+
+	if (l.buf.size() < (size_t) n + 4 * mg + 2)
+		l.buf.resize(n + 4 * mg + 2);
+
+	for (m = n; m >= minm; m /= 2) {
+		h = m / 2;
+
+		// even and odd values of the level extended as af_daub_transform
+		// reads them (up to index m + P - 3), e[i] and o[i] for i in
+		// [-mg, h + mg)
+		e = &l.buf[mg];
+		o = &l.buf[h + 3 * mg];
+		for (i = -mg; i < h + mg; i++) {
+			t = 2 * i;
+			e[i] = t >= 0 && t <= m + l.family - 3 ? y[af_daub_wrap(t, m)] : 0;
+			t++;
+			o[i] = t >= 0 && t <= m + l.family - 3 ? y[af_daub_wrap(t, m)] : 0;
+		}
+
+		// each step computed where its inputs are, the range shrinks
+		elo = olo = -mg;
+		ehi = ohi = h + mg;
+		for (s = 0; s < l.steps.size(); s++) {
+			const af_lift_step &st = l.steps[s];
+			k = st.lo + (int) st.q.size() - 1;
+			if (st.odd) {
+				from = std::max(olo, elo - st.lo);
+				to = std::min(ohi, ehi - k);
+				af_lift_apply(o, e, st, from, to);
+				olo = from;
+				ohi = to;
+			} else {
+				from = std::max(elo, olo - st.lo);
+				to = std::min(ehi, ohi - k);
+				af_lift_apply(e, o, st, from, to);
+				elo = from;
+				ehi = to;
+			}
+		}
+
+		// scaling and the last detail step, in place
+		for (i = 0; i < h; i++) {
+			b = l.kb * o[i + l.sb];
+			for (k = 0; k < nu; k++)
+				b += u[k] * e[i + l.ulo + k];
+			y[i] = l.ka * e[i + l.sa];
+			y[h + i] = b;
+		}
+	}
+}
+
+// factorizations of the families, index family / 2 - 1
+static af_lift af_lift_plans[AF_DAUB_MAX / 2];
+static bool af_lift_ready[AF_DAUB_MAX / 2];
+
+template<int P> static void af_lift_transform_family(int n, const double x[],
+		double y[], double *) {
+
+	af_lift &l = af_lift_plans[P / 2 - 1];
+
+	if (!af_lift_ready[P / 2 - 1]) {
+		af_lift_init(l, P);
+		af_lift_ready[P / 2 - 1] = true;
+	}
+	af_lift_transform(l, n, x, y);
+}
+
+static const af_daub_func af_lift_funcs[AF_DAUB_MAX / 2] = {
+		&af_lift_transform_family<2>, &af_lift_transform_family<4>,
+		&af_lift_transform_family<6>, &af_lift_transform_family<8>,
+		&af_lift_transform_family<10>, &af_lift_transform_family<12>,
+		&af_lift_transform_family<14>, &af_lift_transform_family<16>,
+		&af_lift_transform_family<18>, &af_lift_transform_family<20> };
+
+af_daub_func af_lift_transform_func(int family) {
+	if (af_daub_coefficients(family) == NULL)
+		return NULL;
+	return af_lift_funcs[family / 2 - 1];
+}
+
+double af_lift_check(int family, int n, const double x[]) {
+
+	af_daub_func f = af_daub_transform_isa(family, AF_DAUB_SCALAR);
+	af_lift l;
+	std::vector<double> d(n), z(n), v(n);
+	double dmax = 0, emax = 0;
+	int i;
+
+	if (f == NULL || af_lift_init(l, family))
+		return -1;
+	(*f)(n, x, &d[0], &z[0]);
+	af_lift_transform(l, n, x, &v[0]);
+	for (i = 0; i < n; i++) {
+		dmax = std::max(dmax, fabs(d[i]));
+		emax = std::max(emax, fabs(d[i] - v[i]));
+	}
+	return dmax > 0 ? emax / dmax : emax;
+}
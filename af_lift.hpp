@@ -0,0 +1,70 @@
+/*
+ * af_lift.hpp
+ *
+ * Daubechies transform daubN by lifting steps (selected by --lifting): the
+ * polyphase matrix of the filter pair (even and odd values to approximation
+ * and detail) is factored once per family by the Euclidean algorithm on
+ * Laurent polynomials into steps "odd += q * even" / "even += q * odd" of
+ * mostly 2 taps and a final scaling, about 3P/2 multiplications per pair of
+ * a level instead of 2P of the convolution (af_daub_transform); of all
+ * factorizations the one with the smallest steps is used (rounding)
+ *
+ * Each level is extended behind its end as af_daub_wrap (the same values as
+ * the convolution uses) and by zeros elsewhere, so the result equals
+ * af_daub_transform up to rounding (relative difference below
+ * AF_LIFT_TOLERANCE, checked by --check-lifting)
+ *
+ * No inverse: the mirrored extension of each level is not periodic, values
+ * behind the ends of a level cannot be recovered step by step from its
+ * coefficients
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_LIFT_HPP_
+#define AF_LIFT_HPP_
+
+#include <vector>
+
+#include "af_daub.hpp"
+
+// largest relative difference from af_daub_transform accepted
+#define AF_LIFT_TOLERANCE 1e-9
+
+// step "odd_i += sum q[k] * even_(i + lo + k)" (odd) or the same with even
+// and odd values swapped
+struct af_lift_step {
+	bool odd;
+	int lo;
+	std::vector<double> q;
+};
+
+// factorization of daub<family>: approximation a_i = ka * even_(i + sa),
+// detail b_i = kb * odd_(i + sb) + sum u[k] * even_(i + ulo + k) after steps
+struct af_lift {
+	int family;
+	std::vector<af_lift_step> steps;
+	double ka, kb;
+	int sa, sb;
+	int ulo;
+	std::vector<double> u;
+	int margin;					// values needed before and behind the level
+	std::vector<double> buf;	// even and odd values of the level with margins
+};
+
+// factors daub<family>, returns 0 if ok
+int af_lift_init(af_lift &l, int family);
+
+// transform of x (n values, power of 2) to y (may be x), z unused (the same
+// arguments as af_daub_func); l.buf is workspace, so one thread per l
+void af_lift_transform(af_lift &l, int n, const double x[], double y[]);
+
+// lifting daub<family> (factored at the first call, one thread),
+// NULL if family is not 2, 4, ..., 20
+af_daub_func af_lift_transform_func(int family);
+
+// largest difference of lifting and af_daub_transform of x (n values) relative
+// to the largest coefficient, -1 if family is not 2, 4, ..., 20
+double af_lift_check(int family, int n, const double x[]);
+
+#endif /* AF_LIFT_HPP_ */
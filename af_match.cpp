@@ -0,0 +1,66 @@
+/*
+ * af_match.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cmath>
+
+#include "af_match.hpp"
+
+void af_match_reset(af_match_partial &m, const std::vector<const double *> &bank,
+		int from, int to) {
+
+	unsigned int b;
+	int j;
+
+	m.from = from;
+	m.to = to;
+	m.xx = 0;
+	m.consumed = 0;
+	m.cc.assign(bank.size(), 0.0);
+	m.yy.assign(bank.size(), 0.0);
+	for (b = 0; b < bank.size(); b++)
+		for (j = from; j <= to; j++)
+			m.yy[b] += bank[b][j] * bank[b][j];
+	m.rest = m.yy;
+}
+
+void af_match_add(af_match_partial &m, const std::vector<const double *> &bank,
+		int j, double v) {
+
+	unsigned int b;
+
+	if (j < m.from || j > m.to)
+		return;
+
+	m.xx += v * v;
+	for (b = 0; b < bank.size(); b++) {
+		m.cc[b] += (v - bank[b][j]) * (v - bank[b][j]);
+		m.rest[b] -= bank[b][j] * bank[b][j];
+	}
+}
+
+// distance d = (A + |u - r|^2) / (B + |u|^2) with A, B of known items, u unknown
+// items and r their bank values (|r|^2 = rest); for u = t * r / |r| (extremes)
+// d takes all values between the roots of B d^2 - (A + rest + B) d + A = 0
+double af_match_lower(const af_match_partial &m, int b) {
+
+	double a = m.cc[b];
+	double bb = m.xx + m.yy[b];
+	double rest = m.rest[b] > 0 ? m.rest[b] : 0;
+	double s = a + rest + bb;
+	double disc = s * s - 4 * a * bb;
+	double lo;
+
+	if (!(bb > 0))
+		return 0;
+
+	lo = 2 * a / (s + sqrt(disc > 0 ? disc : 0)) - AF_MATCH_MARGIN;
+	if (lo > 1)
+		lo = 1;
+	if (lo < 0)
+		lo = 0;
+	return lo;
+}
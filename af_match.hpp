@@ -0,0 +1,41 @@
+/*
+ * af_match.hpp
+ *
+ * Bounds of normalized distance (_eucl_dist, distance_calculation 1) of
+ * partially known fingerprint and bank patterns: items of the fingerprint
+ * are added as the streaming transform computes them, the lower bound holds
+ * for any values of the items not known yet
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_MATCH_HPP_
+#define AF_MATCH_HPP_
+
+#include <vector>
+
+// margin of lower bound covering rounding of distance calculation
+#define AF_MATCH_MARGIN 1e-9
+
+struct af_match_partial {
+	int from, to;				// matching items
+	double xx;					// sum of v^2 over known items
+	std::vector<double> cc;		// for bank pattern: sum of (v - b)^2 over known items
+	std::vector<double> rest;	// sum of b^2 over items not known yet
+	std::vector<double> yy;		// sum of b^2 over all items
+	int consumed;				// items of transform taken (see af_dwt.order)
+};
+
+// bank: patterns (items from..to used), no item known
+void af_match_reset(af_match_partial &m, const std::vector<const double *> &bank,
+		int from, int to);
+
+// item j of fingerprint with value v known (ignored outside from..to)
+void af_match_add(af_match_partial &m, const std::vector<const double *> &bank,
+		int j, double v);
+
+// lower bound of normalized distance to bank pattern b (0..1),
+// reduced by AF_MATCH_MARGIN
+double af_match_lower(const af_match_partial &m, int b);
+
+#endif /* AF_MATCH_HPP_ */
@@ -0,0 +1,241 @@
+/*
+ * af_parse.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+#include "af_parse.hpp"
+
+// reads unsigned decimal number (at least one digit, at most 18 digits)
+static inline bool af_read_uint(const char *&p, const char *e, long long &v) {
+	const char *s = p;
+
+	v = 0;
+	while (p < e && (unsigned) (*p - '0') < 10 && p - s < 18) {
+		v = v * 10 + (*p - '0');
+		p++;
+	}
+	return p != s;
+}
+
+// expects character ch at p
+static inline bool af_read_char(const char *&p, const char *e, char ch) {
+	if (p < e && *p == ch) {
+		p++;
+		return true;
+	}
+	return false;
+}
+
+void af_time_cache_reset(af_time_cache &c) {
+	c.n = 0;
+	c.base = 0;
+}
+
+// days since 1970-01-01 for given civil date (proleptic gregorian calendar)
+long long af_days_from_civil(long long y, unsigned m, unsigned d) {
+	long long era;
+	unsigned yoe, doy, doe;
+
+	y -= m <= 2;
+	era = (y >= 0 ? y : y - 399) / 400;
+	yoe = (unsigned) (y - era * 400);
+	doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + (long long) doe - 719468;
+}
+
+// formats microseconds since epoch as "dd-mm-yyyy hh:mm:ss.usec"
+void af_format_timestamp(long long usec, std::string &out) {
+
+	long long days, secs, z, era, y;
+	unsigned doe, yoe, doy, mp, d, m;
+	char buf[64];
+
+	days = (usec >= 0 ? usec : usec - 86400000000LL + 1) / 86400000000LL;
+	usec -= days * 86400000000LL;
+	secs = usec / 1000000;
+	usec %= 1000000;
+
+	// civil from days
+	z = days + 719468;
+	era = (z >= 0 ? z : z - 146096) / 146097;
+	doe = (unsigned) (z - era * 146097);
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	y = (long long) yoe + era * 400;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+	d = doy - (153 * mp + 2) / 5 + 1;
+	m = mp < 10 ? mp + 3 : mp - 9;
+	y += m <= 2;
+
+	snprintf(buf, sizeof(buf), "%02u-%02u-%04lld %02lld:%02lld:%02lld.%06lld", d,
+			m, y, secs / 3600, secs / 60 % 60, secs % 60, usec);
+	out.assign(buf);
+}
+
+// parses timestamp "dd-mm-yyyy hh:mm:ss.usec" to microseconds since epoch
+bool af_parse_timestamp(af_span s, af_time_cache &c, long long &usec) {
+
+	const char *p = s.b;
+	const char *e = s.b + s.n;
+	long long d, m, y, h, mi, sec, us;
+
+	// same day and hour as previous line: only minutes and below are parsed
+	if (c.n && s.n > c.n && s.b[c.n] == ':'
+			&& memcmp(s.b, c.prefix, c.n) == 0) {
+		p += c.n;
+	} else {
+		if (!(af_read_uint(p, e, d) && af_read_char(p, e, '-')
+				&& af_read_uint(p, e, m) && af_read_char(p, e, '-')
+				&& af_read_uint(p, e, y)))
+			return false;
+		if (!af_read_char(p, e, ' '))
+			return false;
+		while (p < e && *p == ' ')
+			p++;
+		if (!af_read_uint(p, e, h))
+			return false;
+		if (m < 1 || m > 12 || d < 1 || d > 31)
+			return false;
+
+		// new base of the hour
+		c.base = ((af_days_from_civil(y, (unsigned) m, (unsigned) d) * 24
+				+ h) * 3600) * 1000000LL;
+		c.n = p - s.b;
+		if (c.n >= sizeof(c.prefix))
+			c.n = 0;	// too long to be cached
+		else
+			memcpy(c.prefix, s.b, c.n);
+	}
+
+	if (!(af_read_char(p, e, ':') && af_read_uint(p, e, mi)
+			&& af_read_char(p, e, ':') && af_read_uint(p, e, sec)))
+		return false;
+
+	// fractional part is optional, taken as integer microseconds
+	us = 0;
+	if (af_read_char(p, e, '.') && !af_read_uint(p, e, us))
+		return false;
+
+	usec = c.base + (mi * 60 + sec) * 1000000LL + us;
+
+	return true;
+}
+
+// powers of 10 exactly representable as double
+static const double af_pow10[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+		1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+		1e20, 1e21, 1e22 };
+
+// true if number ends at p
+static inline bool af_is_number_end(const char *p, const char *e) {
+	return p == e || *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'
+			|| *p == ';';
+}
+
+// parses decimal number at the start of s
+bool af_parse_double(af_span s, double &v) {
+
+	const char *p = s.b;
+	const char *e = s.b + s.n;
+	const char *q;
+	bool neg = false;
+	unsigned long long mant = 0;
+	int ndigits = 0;	// significant digits in mant
+	int exp10 = 0;
+	long long ev;
+	bool eneg;
+	char buf[64];
+	char *end;
+
+	while (p < e && (*p == ' ' || *p == '\t'))
+		p++;
+	s.n -= p - s.b;
+	s.b = p;
+
+	if (p < e && (*p == '-' || *p == '+')) {
+		neg = *p == '-';
+		p++;
+	}
+
+	// integer part (fast path: integer only, e.g. 68998)
+	q = p;
+	while (p < e && (unsigned) (*p - '0') < 10) {
+		if (ndigits < 19) {
+			mant = mant * 10 + (*p - '0');
+			if (mant)
+				ndigits++;
+		} else
+			exp10++;
+		p++;
+	}
+
+	if (af_is_number_end(p, e)) {
+		if (p == q)
+			return false;
+		if (ndigits <= 18) {
+			v = neg ? -(double) (long long) mant : (double) (long long) mant;
+			return true;
+		}
+		goto fallback;
+	}
+
+	// fraction part
+	if (*p == '.') {
+		p++;
+		while (p < e && (unsigned) (*p - '0') < 10) {
+			if (ndigits < 19) {
+				mant = mant * 10 + (*p - '0');
+				if (mant)
+					ndigits++;
+				exp10--;
+			}
+			p++;
+		}
+		if (p == q + 1)
+			return false;	// only '.'
+	} else if (p == q)
+		goto fallback;	// e.g. inf, nan
+
+	// exponent part
+	if (p < e && (*p == 'e' || *p == 'E')) {
+		p++;
+		eneg = false;
+		if (p < e && (*p == '-' || *p == '+')) {
+			eneg = *p == '-';
+			p++;
+		}
+		if (!af_read_uint(p, e, ev))
+			return false;
+		if (ev > 1000)
+			ev = 1000;
+		exp10 += eneg ? -(int) ev : (int) ev;
+	}
+
+	if (!af_is_number_end(p, e))
+		return false;
+
+	// exact when mantissa and power of ten are both exact doubles
+	if (mant <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+		v = exp10 < 0 ? (double) mant / af_pow10[-exp10] :
+				(double) mant * af_pow10[exp10];
+		if (neg)
+			v = -v;
+		return true;
+	}
+
+	fallback:
+	// rare forms, strtod on bounded 0 terminated copy
+	if (s.n >= sizeof(buf))
+		s.n = sizeof(buf) - 1;
+	memcpy(buf, s.b, s.n);
+	buf[s.n] = 0;
+	v = strtod(buf, &end);
+	return end != buf && af_is_number_end(s.b + (end - buf), e);
+}
@@ -0,0 +1,43 @@
+/*
+ * af_parse.hpp
+ *
+ * Allocation free parsing of measurement line fields
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_PARSE_HPP_
+#define AF_PARSE_HPP_
+
+#include "af_input.hpp"
+
+// cache of the last parsed "dd-mm-yyyy hh" timestamp prefix
+// and of its microseconds epoch value (base of the hour)
+struct af_time_cache {
+	char prefix[24];	// prefix text up to the ':' after hour
+	size_t n;			// prefix length, 0 means empty cache
+	long long base;		// microseconds since epoch at the start of the hour
+};
+
+void af_time_cache_reset(af_time_cache &c);
+
+// parses timestamp "dd-mm-yyyy hh:mm:ss.usec" (e.g. 10-03-2016 15:19:20.729915)
+// to microseconds since epoch (UTC calendar, no timezone lookups)
+// the day/hour base is recomputed only when the prefix differs from the cached one
+// returns false if s is not a timestamp of that layout
+bool af_parse_timestamp(af_span s, af_time_cache &c, long long &usec);
+
+// parses decimal number at the start of s (leading blanks allowed),
+// the number must be followed by end of s, blank or ';'
+// integers are converted directly, short decimals exactly (same result as strtod),
+// other forms fall back to strtod; does not throw, returns false if malformed
+bool af_parse_double(af_span s, double &v);
+
+// days since 1970-01-01 for given civil date
+long long af_days_from_civil(long long y, unsigned m, unsigned d);
+
+// formats microseconds since epoch as "dd-mm-yyyy hh:mm:ss.usec" (6 digit usec),
+// i.e. the same text as in input files
+void af_format_timestamp(long long usec, std::string &out);
+
+#endif /* AF_PARSE_HPP_ */
@@ -0,0 +1,79 @@
+/*
+ * af_ring.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+
+#include "af_ring.hpp"
+
+void af_ring_init(af_ring &r, int n, int cap) {
+	r.n = n;
+	r.cap = cap;
+	r.pos = 0;
+	r.filled = false;
+	r.data.assign((size_t) 2 * cap * n, 0.0);
+}
+
+void af_ring_push(af_ring &r, const double *row) {
+
+	size_t sz = r.n * sizeof(double);
+	int i;
+
+	if (!r.filled) {
+		for (i = 0; i < 2 * r.cap; i++)
+			memcpy(&r.data[(size_t) i * r.n], row, sz);
+		r.filled = true;
+		return;
+	}
+
+	memcpy(&r.data[(size_t) r.pos * r.n], row, sz);
+	memcpy(&r.data[(size_t) (r.pos + r.cap) * r.n], row, sz);
+	if (++r.pos == r.cap)
+		r.pos = 0;
+}
+
+void af_ring_push_rows(af_ring &r, const double *rows, int count) {
+
+	int i = count > r.cap ? count - r.cap : 0;
+
+	// the first row fills the whole ring if no row was pushed yet
+	if (!r.filled && count > 0) {
+		af_ring_push(r, rows);
+		if (i == 0)
+			i = 1;
+	}
+	for (; i < count; i++)
+		af_ring_push(r, rows + (size_t) i * r.n);
+}
+
+double *af_ring_window(af_ring &r, int len, int back) {
+
+	// first row of window, the copy of the ring follows it
+	int start = r.pos - back - len;
+
+	while (start < 0)
+		start += r.cap;
+
+	return &r.data[(size_t) start * r.n];
+}
+
+void af_ring_column(af_ring &r, int c, int len, int back, bool use_diff,
+		double *out) {
+
+	const double *w;
+	int i;
+
+	if (!use_diff) {
+		w = af_ring_window(r, len, back) + c;
+		for (i = 0; i < len; i++)
+			out[i] = w[(size_t) i * r.n];
+		return;
+	}
+
+	w = af_ring_window(r, len + 1, back) + c;
+	for (i = 0; i < len; i++)
+		out[i] = w[(size_t) (i + 1) * r.n] - w[(size_t) i * r.n];
+}
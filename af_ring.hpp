@@ -0,0 +1,52 @@
+/*
+ * af_ring.hpp
+ *
+ * Ring buffer of the last input rows (one value per column), allocated once.
+ * Each row is stored twice (at pos and pos + cap), so that any window of up
+ * to cap consecutive rows is contiguous in memory and may be handed to the
+ * wavelet transform without copying (single column input)
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_RING_HPP_
+#define AF_RING_HPP_
+
+#include <vector>
+
+struct af_ring {
+	int n;						// values in row (columns)
+	int cap;					// number of rows kept
+	int pos;					// slot of the next row
+	bool filled;				// false until the first row is pushed
+	std::vector<double> data;	// 2 * cap rows
+};
+
+// pattern being collected: window of the ring ending count rows later
+struct af_window {
+	int patternid;
+	int count;					// rows to the end of pattern
+	int dwt;					// streaming transform of pattern (-1: none)
+	int early;					// decided while collected: 1 match raised, -1 no match
+};
+
+// allocates ring of cap rows with n values each
+void af_ring_init(af_ring &r, int n, int cap);
+
+// appends row[0..n), the oldest row is dropped
+// the first row pushed fills the whole ring (history before input start is constant)
+void af_ring_push(af_ring &r, const double *row);
+
+// appends count rows (rows[0..count * n)), only the last cap of them are copied
+void af_ring_push_rows(af_ring &r, const double *rows, int count);
+
+// start of window of len rows ending back rows before the last pushed row
+// (back = 0: window ends by the last row), rows follow with stride n
+double *af_ring_window(af_ring &r, int len, int back);
+
+// values of column c of the window to out[0..len)
+// use_diff: differences to preceding rows instead of values (needs len + back < cap)
+void af_ring_column(af_ring &r, int c, int len, int back, bool use_diff,
+		double *out);
+
+#endif /* AF_RING_HPP_ */
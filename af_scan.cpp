@@ -0,0 +1,116 @@
+/*
+ * af_scan.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include "af_scan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AF_SCAN_X86
+#endif
+
+// scalar scan of b[i..n), k offsets already written, returns new k
+// (whole scalar version and tails of the vector versions)
+static inline size_t af_scan_tail(const char *b, size_t i, size_t n,
+		uint32_t *pos, size_t k) {
+	for (; i < n; i++)
+		if (b[i] == ';' || b[i] == '\n')
+			pos[k++] = i;
+	return k;
+}
+
+#ifdef AF_SCAN_X86
+
+// 16 bytes per step
+static size_t af_scan_sse2(const char *b, size_t n, uint32_t *pos) {
+	const __m128i sc = _mm_set1_epi8(';');
+	const __m128i nl = _mm_set1_epi8('\n');
+	__m128i x;
+	unsigned int mask;
+	size_t k = 0;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		x = _mm_loadu_si128((const __m128i *) (b + i));
+		mask = _mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(x, sc), _mm_cmpeq_epi8(x, nl)));
+		while (mask) {
+			pos[k++] = i + __builtin_ctz(mask);
+			mask &= mask - 1;
+		}
+	}
+
+	return af_scan_tail(b, i, n, pos, k);
+}
+
+// 64 bytes per step
+__attribute__((target("avx2")))
+static size_t af_scan_avx2(const char *b, size_t n, uint32_t *pos) {
+	const __m256i sc = _mm256_set1_epi8(';');
+	const __m256i nl = _mm256_set1_epi8('\n');
+	__m256i x0, x1;
+	uint64_t mask;
+	size_t k = 0;
+	size_t i;
+
+	for (i = 0; i + 64 <= n; i += 64) {
+		x0 = _mm256_loadu_si256((const __m256i *) (b + i));
+		x1 = _mm256_loadu_si256((const __m256i *) (b + i + 32));
+		mask = (uint32_t) _mm256_movemask_epi8(
+				_mm256_or_si256(_mm256_cmpeq_epi8(x0, sc),
+						_mm256_cmpeq_epi8(x0, nl)))
+				| (uint64_t) (uint32_t) _mm256_movemask_epi8(
+						_mm256_or_si256(_mm256_cmpeq_epi8(x1, sc),
+								_mm256_cmpeq_epi8(x1, nl))) << 32;
+		while (mask) {
+			pos[k++] = i + __builtin_ctzll(mask);
+			mask &= mask - 1;
+		}
+	}
+
+	return af_scan_tail(b, i, n, pos, k);
+}
+
+#endif
+
+// selected implementation
+#ifdef AF_SCAN_X86
+static size_t (*af_scan_func)(const char *, size_t, uint32_t *) = NULL;
+#endif
+static const char *af_scan_func_name = "scalar";
+
+// selects scanner implementation for the current CPU
+void af_scan_init() {
+#ifdef AF_SCAN_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		af_scan_func = &af_scan_avx2;
+		af_scan_func_name = "avx2";
+	} else {
+		af_scan_func = &af_scan_sse2;
+		af_scan_func_name = "sse2";
+	}
+#endif
+}
+
+const char *af_scan_name() {
+#ifdef AF_SCAN_X86
+	if (af_scan_func == NULL)
+		af_scan_init();
+#endif
+	return af_scan_func_name;
+}
+
+// writes offsets of all ';' and '\n' in b[0..n) to pos
+size_t af_scan(const char *b, size_t n, uint32_t *pos) {
+#ifdef AF_SCAN_X86
+	if (af_scan_func == NULL)
+		af_scan_init();
+	return (*af_scan_func)(b, n, pos);
+#else
+	return af_scan_tail(b, 0, n, pos, 0);
+#endif
+}
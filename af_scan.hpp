@@ -0,0 +1,29 @@
+/*
+ * af_scan.hpp
+ *
+ * Structural scanner of CSV text: finds positions of field (';')
+ * and line ('\n') delimiters in chunks, using SSE2/AVX2 when available
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_SCAN_HPP_
+#define AF_SCAN_HPP_
+
+#include <cstddef>
+#include <stdint.h>
+
+// size of scanned chunk, also maximum number of positions found in it
+#define AF_SCAN_CHUNK 65536
+
+// selects scanner implementation for the current CPU (called once, optional)
+void af_scan_init();
+
+// name of selected scanner implementation ("avx2", "sse2" or "scalar")
+const char *af_scan_name();
+
+// writes offsets of all ';' and '\n' in b[0..n) to pos, in increasing order
+// n must be <= AF_SCAN_CHUNK, returns number of offsets written
+size_t af_scan(const char *b, size_t n, uint32_t *pos);
+
+#endif /* AF_SCAN_HPP_ */
@@ -0,0 +1,311 @@
+/*
+ * af_uring.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "af_uring.hpp"
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define AF_URING_IO_URING
+#endif
+
+// reads want bytes to b from offset off (less only at the end of file)
+// returns number of bytes read or -1 on error
+static long af_pread_full(int fd, char *b, size_t want, off_t off) {
+	long got;
+	size_t n = 0;
+
+	while (n < want) {
+		got = pread(fd, b + n, want - n, off + n);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got < 0)
+			return -1;
+		if (got == 0)
+			break;
+		n += got;
+	}
+
+	return n;
+}
+
+#ifdef AF_URING_IO_URING
+
+// sets up io_uring for entries reads, returns 0 if ok
+static int af_uring_setup(af_uring_ring &q, unsigned entries) {
+
+	struct io_uring_params p;
+
+	memset(&p, 0, sizeof(p));
+	q.fd = syscall(__NR_io_uring_setup, entries, &p);
+	if (q.fd < 0) {
+		q.fd = -1;
+		return 1;
+	}
+
+	q.sqmaplen = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	q.cqmaplen = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if ((p.features & IORING_FEAT_SINGLE_MMAP) && q.cqmaplen > q.sqmaplen)
+		q.sqmaplen = q.cqmaplen;
+	q.sqeslen = p.sq_entries * sizeof(struct io_uring_sqe);
+
+	q.sqmap = mmap(NULL, q.sqmaplen, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, q.fd, IORING_OFF_SQ_RING);
+	q.cqmap = q.sqmap;
+	if (q.sqmap != MAP_FAILED && !(p.features & IORING_FEAT_SINGLE_MMAP))
+		q.cqmap = mmap(NULL, q.cqmaplen, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, q.fd, IORING_OFF_CQ_RING);
+	q.sqes = mmap(NULL, q.sqeslen, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, q.fd, IORING_OFF_SQES);
+
+	if (q.sqmap == MAP_FAILED || q.cqmap == MAP_FAILED
+			|| q.sqes == MAP_FAILED) {
+		if (q.sqes != MAP_FAILED)
+			munmap(q.sqes, q.sqeslen);
+		if (q.cqmap != MAP_FAILED && q.cqmap != q.sqmap)
+			munmap(q.cqmap, q.cqmaplen);
+		if (q.sqmap != MAP_FAILED)
+			munmap(q.sqmap, q.sqmaplen);
+		close(q.fd);
+		q.fd = -1;
+		return 1;
+	}
+
+	q.sqtail = (unsigned *) ((char *) q.sqmap + p.sq_off.tail);
+	q.sqmask = (unsigned *) ((char *) q.sqmap + p.sq_off.ring_mask);
+	q.sqarray = (unsigned *) ((char *) q.sqmap + p.sq_off.array);
+	q.cqhead = (unsigned *) ((char *) q.cqmap + p.cq_off.head);
+	q.cqtail = (unsigned *) ((char *) q.cqmap + p.cq_off.tail);
+	q.cqmask = (unsigned *) ((char *) q.cqmap + p.cq_off.ring_mask);
+	q.cqes = (char *) q.cqmap + p.cq_off.cqes;
+
+	return 0;
+}
+
+static void af_uring_teardown(af_uring_ring &q) {
+	if (q.fd < 0)
+		return;
+	munmap(q.sqes, q.sqeslen);
+	if (q.cqmap != q.sqmap)
+		munmap(q.cqmap, q.cqmaplen);
+	munmap(q.sqmap, q.sqmaplen);
+	close(q.fd);
+	q.fd = -1;
+}
+
+// queues read of buffer i (submitted by af_uring_enter)
+static void af_uring_queue(af_uring_reader &r, int i) {
+
+	af_uring_ring &q = r.ring;
+	unsigned tail = *q.sqtail;
+	unsigned k = tail & *q.sqmask;
+	struct io_uring_sqe *sqe = (struct io_uring_sqe *) q.sqes + k;
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_READV;
+	sqe->fd = r.fd;
+	sqe->off = r.off[i];
+	sqe->addr = (unsigned long) &r.iov[i];
+	sqe->len = 1;
+	sqe->user_data = i;
+
+	q.sqarray[k] = k;
+	__atomic_store_n(q.sqtail, tail + 1, __ATOMIC_RELEASE);
+}
+
+// submits n queued reads and waits for min_complete completions
+static int af_uring_enter(af_uring_reader &r, unsigned n, unsigned min_complete) {
+	long ret;
+
+	do
+		ret = syscall(__NR_io_uring_enter, r.ring.fd, n, min_complete,
+				min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	while (ret < 0 && errno == EINTR);
+
+	return ret < 0;
+}
+
+// takes all completions, failed reads are repeated by pread later
+static void af_uring_reap(af_uring_reader &r) {
+
+	af_uring_ring &q = r.ring;
+	unsigned head = *q.cqhead;
+	struct io_uring_cqe *cqe;
+
+	while (head != __atomic_load_n(q.cqtail, __ATOMIC_ACQUIRE)) {
+		cqe = (struct io_uring_cqe *) q.cqes + (head & *q.cqmask);
+		r.len[cqe->user_data] = cqe->res < 0 ? 0 : cqe->res;
+		head++;
+	}
+	__atomic_store_n(q.cqhead, head, __ATOMIC_RELEASE);
+}
+
+#endif
+
+// starts reads of all free buffers
+static int af_uring_fill(af_uring_reader &r) {
+
+	unsigned queued = 0;
+	int i;
+
+	while (r.inflight < r.depth && r.next < r.size) {
+		i = (r.cur + r.inflight) % r.depth;
+		r.off[i] = r.next;
+		r.want[i] = r.size - r.next;
+		if (r.want[i] > AF_URING_BLOCK)
+			r.want[i] = AF_URING_BLOCK;
+		r.iov[i].iov_base = r.bufs[i];
+		r.iov[i].iov_len = r.want[i];
+		r.next += r.want[i];
+		r.inflight++;
+
+		// fallback: read now
+		if (r.ring.fd < 0) {
+			r.len[i] = af_pread_full(r.fd, r.bufs[i], r.want[i], r.off[i]);
+			if (r.len[i] < 0)
+				return 1;
+			continue;
+		}
+
+#ifdef AF_URING_IO_URING
+		r.len[i] = -1;
+		af_uring_queue(r, i);
+		queued++;
+#endif
+	}
+
+#ifdef AF_URING_IO_URING
+	if (queued && af_uring_enter(r, queued, 0))
+		return 1;
+#endif
+
+	return 0;
+}
+
+int af_uring_open(af_uring_reader &r, int fd, off_t start, int depth) {
+
+	struct stat st;
+	int i;
+
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+		return 1;
+
+	if (depth < 1)
+		depth = 1;
+	if (depth > AF_URING_DEPTH_MAX)
+		depth = AF_URING_DEPTH_MAX;
+
+	r.fd = fd;
+	r.depth = depth;
+	r.cur = 0;
+	r.pos = 0;
+	r.inflight = 0;
+	r.next = start;
+	r.size = st.st_size;
+	for (i = 0; i < depth; i++) {
+		r.bufs[i] = new char[AF_URING_BLOCK];
+		r.len[i] = 0;
+	}
+
+	r.ring.fd = -1;
+#ifdef AF_URING_IO_URING
+	af_uring_setup(r.ring, depth);
+#endif
+
+	// error of the first reads is reported by af_uring_read
+	af_uring_fill(r);
+
+	return 0;
+}
+
+void af_uring_close(af_uring_reader &r) {
+
+	int i;
+
+#ifdef AF_URING_IO_URING
+	// buffers must not be released while kernel still writes to them
+	while (r.ring.fd >= 0) {
+		for (i = 0; i < r.inflight; i++)
+			if (r.len[(r.cur + i) % r.depth] < 0)
+				break;
+		if (i == r.inflight || af_uring_enter(r, 0, 1))
+			break;
+		af_uring_reap(r);
+	}
+	af_uring_teardown(r.ring);
+#endif
+
+	for (i = 0; i < r.depth; i++)
+		delete[] r.bufs[i];
+	r.depth = 0;
+	r.inflight = 0;
+}
+
+// copies data of buffers in order of file offsets, the next reads run meanwhile
+long af_uring_read(void *ctx, char *dst, size_t cap) {
+
+	af_uring_reader &r = *(af_uring_reader *) ctx;
+	long got;
+	size_t n;
+	int i;
+
+	for (;;) {
+		if (r.inflight == 0) {
+			if (r.next < r.size && af_uring_fill(r))
+				return -1;
+			if (r.inflight == 0)
+				return 0;
+		}
+		i = r.cur;
+
+#ifdef AF_URING_IO_URING
+		// wait for buffer in order
+		while (r.len[i] < 0) {
+			if (af_uring_enter(r, 0, 1))
+				return -1;
+			af_uring_reap(r);
+		}
+#endif
+
+		// rest of short or failed read
+		if (r.pos == 0 && (size_t) r.len[i] < r.want[i]) {
+			got = af_pread_full(r.fd, r.bufs[i] + r.len[i],
+					r.want[i] - r.len[i], r.off[i] + r.len[i]);
+			if (got < 0)
+				return -1;
+			r.len[i] += got;
+		}
+
+		n = r.len[i] - r.pos;
+		if (n > cap)
+			n = cap;
+		memcpy(dst, r.bufs[i] + r.pos, n);
+		r.pos += n;
+
+		// buffer consumed, read next data into it
+		if (r.pos >= (size_t) r.len[i]) {
+			r.pos = 0;
+			r.cur = (r.cur + 1) % r.depth;
+			r.inflight--;
+			if (af_uring_fill(r))
+				return -1;
+		}
+
+		if (n > 0)
+			return n;
+	}
+}
+
+const char *af_uring_name(const af_uring_reader &r) {
+	return r.ring.fd >= 0 ? "io_uring" : "pread";
+}
@@ -0,0 +1,62 @@
+/*
+ * af_uring.hpp
+ *
+ * Asynchronous reader of input file: several large reads are kept in flight
+ * using io_uring while the previously read buffer is parsed,
+ * plain pread is used where io_uring is not available
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_URING_HPP_
+#define AF_URING_HPP_
+
+#include <cstddef>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// size of one read
+#define AF_URING_BLOCK (1024 * 1024)
+// maximum number of reads in flight
+#define AF_URING_DEPTH_MAX 16
+
+// io_uring instance (rings mapped from kernel)
+struct af_uring_ring {
+	int fd;					// -1 if not used (pread fallback)
+	void *sqmap, *cqmap, *sqes;
+	size_t sqmaplen, cqmaplen, sqeslen;
+	unsigned *sqtail, *sqmask, *sqarray;
+	unsigned *cqhead, *cqtail, *cqmask;
+	void *cqes;
+};
+
+// reader of regular file from given offset to the end of the file
+// buffers are read in order of offsets and consumed in the same order
+struct af_uring_reader {
+	af_uring_ring ring;
+	int fd;
+	int depth;						// number of buffers
+	char *bufs[AF_URING_DEPTH_MAX];
+	struct iovec iov[AF_URING_DEPTH_MAX];
+	off_t off[AF_URING_DEPTH_MAX];	// file offset of buffer
+	long len[AF_URING_DEPTH_MAX];	// bytes read to buffer, < 0 while in flight
+	size_t want[AF_URING_DEPTH_MAX];	// bytes requested
+	int cur;						// buffer being consumed
+	size_t pos;						// consumed bytes of current buffer
+	int inflight;					// buffers submitted and not consumed
+	off_t next;						// offset of the next read
+	off_t size;						// file size at open
+};
+
+// opens reader of regular file fd from offset start with depth buffers
+// returns 0 if ok, 1 if fd is not a regular file (use af_fd_read then)
+int af_uring_open(af_uring_reader &r, int fd, off_t start, int depth);
+void af_uring_close(af_uring_reader &r);
+
+// source for af_text_open_source, ctx points to af_uring_reader
+long af_uring_read(void *ctx, char *dst, size_t cap);
+
+// "io_uring" or "pread"
+const char *af_uring_name(const af_uring_reader &r);
+
+#endif /* AF_URING_HPP_ */
@@ -0,0 +1,80 @@
+/*
+ * af_wdet.cpp
+ *
+ *
+ *      Author: Martin Saly
+ */
+
+#include <cmath>
+#include <string>
+
+#include "af_wdet.hpp"
+#include "wavelet_ms.hpp"
+
+int af_wdet_init(af_wdet &w, int family) {
+
+	double *c;
+	int k;
+
+	if (family < 2 || family > 20 || family % 2)
+		return 1;
+
+	c = daub_coefficients(family);
+	w.p = family;
+	w.lo.assign(c, c + family);
+	delete[] c;
+
+	w.hi.resize(w.p);
+	for (k = 0; k < w.p; k++)
+		w.hi[k] = (k % 2 ? -1 : 1) * w.lo[w.p - 1 - k];
+
+	w.x.assign(w.p, 0.0);
+	w.a.assign(2 * w.p - 1, 0.0);
+	w.xpos = w.apos = 0;
+	w.filled = false;
+
+	return 0;
+}
+
+double af_wdet_next(af_wdet &w, double x) {
+
+	int n = w.p;
+	int na = 2 * w.p - 1;
+	double a1 = 0, d1 = 0, d2 = 0;
+	int k, i;
+
+	// history before the first value is constant (no details)
+	if (!w.filled) {
+		for (k = 0; k < n; k++)
+			a1 += w.lo[k] * x;
+		w.x.assign(n, x);
+		w.a.assign(na, a1);
+		a1 = 0;
+		w.filled = true;
+	}
+
+	w.x[w.xpos] = x;
+	if (++w.xpos == n)
+		w.xpos = 0;
+
+	// first level: x[t - k] is at xpos - 1 - k
+	for (k = 0, i = w.xpos - 1; k < n; k++, i--) {
+		if (i < 0)
+			i += n;
+		a1 += w.lo[k] * w.x[i];
+		d1 += w.hi[k] * w.x[i];
+	}
+
+	w.a[w.apos] = a1;
+	if (++w.apos == na)
+		w.apos = 0;
+
+	// second level on approximations, filter dilated by 2
+	for (k = 0, i = w.apos - 1; k < n; k++, i -= 2) {
+		if (i < 0)
+			i += na;
+		d2 += w.hi[k] * w.a[i];
+	}
+
+	return sqrt(d1 * d1 + d2 * d2);
+}
@@ -0,0 +1,33 @@
+/*
+ * af_wdet.hpp
+ *
+ * Wavelet energy detector: first and second level Daubechies details of the
+ * signal computed for each sample by sliding (undecimated) filters of
+ * daub_coefficients, O(p) per sample. Detector value is the magnitude of both
+ * details sqrt(d1^2 + d2^2), used instead of |diff| against the noise level
+ *
+ *      Author: Martin Saly
+ */
+
+#ifndef AF_WDET_HPP_
+#define AF_WDET_HPP_
+
+#include <vector>
+
+struct af_wdet {
+	int p;						// filter length
+	std::vector<double> lo;		// low pass filter (daub_coefficients)
+	std::vector<double> hi;		// high pass filter, hi[k] = (-1)^k lo[p - 1 - k]
+	std::vector<double> x;		// last p values (x[pos] the oldest)
+	std::vector<double> a;		// last 2p - 1 first level approximations
+	int xpos, apos;
+	bool filled;				// false until the first value
+};
+
+// detector with filters of daub<family>, returns 0 if ok
+int af_wdet_init(af_wdet &w, int family);
+
+// next value, returns detector value
+double af_wdet_next(af_wdet &w, double x);
+
+#endif /* AF_WDET_HPP_ */
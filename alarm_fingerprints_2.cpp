@@ -9,6 +9,63 @@
 /*
  standalone program version to be run using:
  alarm_fingerprints [options] < datafile
+ or (input file memory mapped, faster for large files):
+ alarm_fingerprints [options] -F datafile
+
+ input can be converted to binary format file (much faster to process repeatedly):
+ alarm_fingerprints -C datafile.bin < datafile
+ alarm_fingerprints [options] -F datafile.bin
+
+ more measured values in one line (timestamp; value1; value2; ...) are evaluated
+ independently, each with own alarm detection and patterns, using:
+ alarm_fingerprints [options] -N 2 < datafile
+
+ file growing during the run (e.g. written by acquisition) can be followed:
+ alarm_fingerprints [options] -T 1 -F datafile
+
+ text input file on slow disk can be read asynchronously (reads overlap with processing):
+ alarm_fingerprints [options] -U 4 -F datafile
+
+ mostly quiet single signal is processed faster in block mode (same results):
+ alarm_fingerprints [options] -B 1024 -F datafile
+ and faster still, quiet runs skipped by their summary (diffavg equal up to rounding):
+ alarm_fingerprints [options] -B 4096 -Q 64 -F datafile.bin
+
+ patterns can be transformed while collected (faster decision after pattern end):
+ alarm_fingerprints [options] -S 1 < datafile
+ and decided before their end when no bank pattern can match any more:
+ alarm_fingerprints [options] -S 1 -E 1 < datafile
+
+ alarms detected by wavelet details energy instead of differences of values:
+ alarm_fingerprints [options] -D 1 < datafile
+
+ noise level of the detector estimated by streaming median (robust against spikes):
+ alarm_fingerprints [options] -A 1 < datafile
+
+ alarms during collection of pattern can start own (overlapping) patterns:
+ alarm_fingerprints [options] -O 8 < datafile
+
+ patterns (fingerprints) can include values before the alarm (onset of the event):
+ alarm_fingerprints [options] --pre-trigger 16 < datafile
+
+ detector state (noise level, alarm and pattern state) can be saved periodically
+ and restored after restart, without warm-up and without losing patterns in progress:
+ alarm_fingerprints [options] --checkpoint state.afc --checkpoint-interval 60 -T 2 -F datafile
+ alarm_fingerprints [options] --checkpoint state.afc --resume -T 2 -F datafile
+
+ patterns can be transformed by lifting steps of the wavelet (less arithmetic,
+ the same fingerprints up to rounding, checked on the fingerprints of -p directory):
+ alarm_fingerprints [options] --lifting < datafile
+ alarm_fingerprints -p fingerprints/ --check-lifting
+
+ compressed input (gzip) is recognized and decompressed on a separate thread:
+ alarm_fingerprints [options] -F datafile.gz
+ alarm_fingerprints [options] < datafile.gz
+
+ time range of large input file can be processed without reading it from the start
+ using its timestamp index (built once):
+ alarm_fingerprints --build-index=60 -F datafile
+ alarm_fingerprints [options] --from "10-03-2016 15:19:00" --to "10-03-2016 15:24:00" -F datafile
 
  e.g.:
  ./alarm_fingerprints -s 1 -p 5 -d 2 < testdata.csv
@@ -51,6 +108,25 @@
  -x corresponds to: skip_if_contains
  -y corresponds to: matching_distance_positives_max
  -z corresponds to: matching_distance_negatives_max
+ -C corresponds to: convert_file
+ -N corresponds to: columns
+ -T corresponds to: follow_input
+ -U corresponds to: async_reads
+ -B corresponds to: block_size
+ -Q corresponds to: quiet_skip
+ -O corresponds to: max_windows
+ -S corresponds to: stream_transform
+ -E corresponds to: early_decision
+ -D corresponds to: detector
+ -A corresponds to: baseline
+ --from, --to correspond to: from, to
+ --lead-in corresponds to: lead_in_sec
+ --build-index corresponds to: index_interval_sec
+ --pre-trigger corresponds to: pre_trigger
+ --checkpoint, --checkpoint-interval correspond to: checkpoint_file, checkpoint_interval_sec
+ --resume corresponds to: resume
+ --lifting, --check-lifting correspond to: lifting, check_lifting
+ -F corresponds to: input_file
 
  After processing, following data are outputted (if -d is 1):
  (I) Parameters values overview
@@ -92,6 +168,11 @@
 #include <unistd.h>
 #include <dirent.h>
 #include <regex>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <getopt.h>
+#include <climits>
 
 #include "alarm_fingerprints_2.hpp"
 
@@ -114,7 +195,7 @@ int main(int argc, char* argv[]) {
 	_fingerprint_match_positives_to = 511;
 	_fingerprint_match_negatives_to = 511;
 	_wavelet_function = 2;
-	_wav_func = &daub2_transform; // default pointer to function
+	_wav_func = af_daub_transform_func(_wavelet_function); // default pointer to function
 	_generate_fingerprints = 0;
 	_matching_distance_positives_max = 0.5;
 	_matching_distance_negatives_max = 0.5;
@@ -125,6 +206,28 @@ int main(int argc, char* argv[]) {
 	_debug_level = 0;
 	_matchdistance_to_output = 0;
 	_genpattern_hour_limit = 0;
+	_input_file = "";
+	_convert_file = "";
+	_columns = 1;
+	_follow_input = 0;
+	_async_reads = 0;
+	_block_size = 0;
+	_quiet_skip = 0;
+	_max_windows = 1;
+	_stream_transform = 0;
+	_early_decision = 0;
+	_detector = 0;
+	_baseline = 0;
+	_from = "";
+	_to = "";
+	_lead_in_sec = 10;
+	_index_interval_sec = 0;
+	_pre_trigger = 0;
+	_checkpoint_file = "";
+	_checkpoint_interval_sec = 60;
+	_resume = 0;
+	_lifting = 0;
+	_check_lifting = 0;
 
 
 	// debug
@@ -133,9 +236,24 @@ int main(int argc, char* argv[]) {
 
 
 	// parse and amend arguments (if present) ///////////////////////////////////////////////
+	// long options without short equivalent
+	static const struct option long_options[] = {
+			{ "from", required_argument, NULL, 1001 },
+			{ "to", required_argument, NULL, 1002 },
+			{ "lead-in", required_argument, NULL, 1003 },
+			{ "build-index", optional_argument, NULL, 1004 },
+			{ "pre-trigger", required_argument, NULL, 1005 },
+			{ "checkpoint", required_argument, NULL, 1006 },
+			{ "checkpoint-interval", required_argument, NULL, 1007 },
+			{ "resume", no_argument, NULL, 1008 },
+			{ "lifting", no_argument, NULL, 1009 },
+			{ "check-lifting", no_argument, NULL, 1010 },
+			{ NULL, 0, NULL, 0 } };
+
 	opterr = 0;
-	while ((co = getopt(argc, argv,
-			"a:bc:d:e:f:g:hi:j:k:l:m:n:op:r:s:t:u:w:x:y:z:")) != EOF) {
+	while ((co = getopt_long(argc, argv,
+			"a:bc:d:e:f:g:hi:j:k:l:m:n:op:r:s:t:u:w:x:y:z:A:B:C:D:E:F:N:O:Q:S:T:U:",
+			long_options, NULL)) != EOF) {
 
 		//debug
 		// std::cout << "(debug) co: " << (char) co << std::endl;
@@ -404,38 +522,8 @@ int main(int argc, char* argv[]) {
 				return 1;
 			}
 
-			switch (_wavelet_function) {
-			case 2:
-				_wav_func = &daub2_transform;
-				break;
-			case 4:
-				_wav_func = &daub4_transform;
-				break;
-			case 6:
-				_wav_func = &daub6_transform;
-				break;
-			case 8:
-				_wav_func = &daub8_transform;
-				break;
-			case 10:
-				_wav_func = &daub10_transform;
-				break;
-			case 12:
-				_wav_func = &daub12_transform;
-				break;
-			case 14:
-				_wav_func = &daub14_transform;
-				break;
-			case 16:
-				_wav_func = &daub16_transform;
-				break;
-			case 18:
-				_wav_func = &daub18_transform;
-				break;
-			case 20:
-				_wav_func = &daub20_transform;
-				break;
-			default:
+			_wav_func = af_daub_transform_func(_wavelet_function);
+			if (_wav_func == NULL) {
 				DLOG(LOG_ERROR,
 						"With -w use one of the following:\n2,4,6,8,10,12,14,16,18,20\nExiting");
 				return 1;
@@ -480,6 +568,258 @@ int main(int argc, char* argv[]) {
 			_skip_if_contains = optarg;
 			break;
 
+		case 'F':
+			_input_file = optarg;
+			break;
+
+		case 'C':
+			_convert_file = optarg;
+			break;
+
+		case 'N':
+			try {
+				_columns = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_columns >= 1)) {
+				DLOG(LOG_ERROR, "\ncolumns (-N) must be >= 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'T':
+			try {
+				_follow_input = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_follow_input >= 0 && _follow_input <= 2)) {
+				DLOG(LOG_ERROR, "\nfollow_input (-T) must be 0, 1 or 2\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'B':
+			try {
+				_block_size = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_block_size >= 0 && _block_size <= 65536)) {
+				DLOG(LOG_ERROR,
+						"\nblock_size (-B) must be >= 0 and <= 65536\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'Q':
+			try {
+				_quiet_skip = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_quiet_skip >= 0 && _quiet_skip <= 65536)) {
+				DLOG(LOG_ERROR,
+						"\nquiet_skip (-Q) must be >= 0 and <= 65536\nExiting");
+				return 1;
+			}
+			break;
+
+		case 1001:
+			_from = optarg;
+			break;
+
+		case 1002:
+			_to = optarg;
+			break;
+
+		case 1003:
+			try {
+				_lead_in_sec = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR, "\nParameter error near --lead-in\nExiting");
+				return 1;
+			}
+			if (!(_lead_in_sec >= 0)) {
+				DLOG(LOG_ERROR, "\nlead_in_sec (--lead-in) must be >= 0\nExiting");
+				return 1;
+			}
+			break;
+
+		case 1004:
+			_index_interval_sec = 60;
+			if (optarg != NULL) {
+				try {
+					_index_interval_sec = std::stoi(optarg);
+				} catch (const std::exception &exc) {
+					DLOG(LOG_ERROR,
+							"\nParameter error near --build-index\nExiting");
+					return 1;
+				}
+			}
+			if (!(_index_interval_sec >= 1)) {
+				DLOG(LOG_ERROR,
+						"\nindex_interval_sec (--build-index) must be >= 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 1005:
+			try {
+				_pre_trigger = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR, "\nParameter error near --pre-trigger\nExiting");
+				return 1;
+			}
+			if (!(_pre_trigger >= 0)) {
+				DLOG(LOG_ERROR, "\npre_trigger (--pre-trigger) must be >= 0\nExiting");
+				return 1;
+			}
+			break;
+
+		case 1006:
+			_checkpoint_file = optarg;
+			break;
+
+		case 1007:
+			try {
+				_checkpoint_interval_sec = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near --checkpoint-interval\nExiting");
+				return 1;
+			}
+			if (!(_checkpoint_interval_sec >= 1)) {
+				DLOG(LOG_ERROR,
+						"\ncheckpoint_interval_sec (--checkpoint-interval) must be >= 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 1008:
+			_resume = 1;
+			break;
+
+		case 1009:
+			_lifting = 1;
+			break;
+
+		case 1010:
+			_check_lifting = 1;
+			break;
+
+		case 'O':
+			try {
+				_max_windows = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_max_windows >= 1 && _max_windows <= AF_WINDOWS_MAX)) {
+				DLOG(LOG_ERROR,
+						"\nmax_windows (-O) must be >= 1 and <= "
+								+ std::to_string(AF_WINDOWS_MAX)
+								+ "\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'S':
+			try {
+				_stream_transform = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_stream_transform == 0 || _stream_transform == 1)) {
+				DLOG(LOG_ERROR,
+						"\nstream_transform (-S) must be 0 or 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'D':
+			try {
+				_detector = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_detector == 0 || _detector == 1)) {
+				DLOG(LOG_ERROR, "\ndetector (-D) must be 0 or 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'A':
+			try {
+				_baseline = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_baseline == AF_BASELINE_EWMA
+					|| _baseline == AF_BASELINE_MEDIAN)) {
+				DLOG(LOG_ERROR, "\nbaseline (-A) must be 0 or 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'E':
+			try {
+				_early_decision = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_early_decision == 0 || _early_decision == 1)) {
+				DLOG(LOG_ERROR,
+						"\nearly_decision (-E) must be 0 or 1\nExiting");
+				return 1;
+			}
+			break;
+
+		case 'U':
+			try {
+				_async_reads = std::stoi(optarg);
+			} catch (const std::exception &exc) {
+				DLOG(LOG_ERROR,
+						"\nParameter error near " + std::string(1, co)
+								+ "\nExiting");
+				return 1;
+			}
+			if (!(_async_reads >= 0 && _async_reads <= AF_URING_DEPTH_MAX)) {
+				DLOG(LOG_ERROR,
+						"\nasync_reads (-U) must be >= 0 and <= "
+								+ std::to_string(AF_URING_DEPTH_MAX)
+								+ "\nExiting");
+				return 1;
+			}
+			break;
+
 		case 'd':
 			try {
 				_debug_level = std::stoi(optarg);
@@ -512,7 +852,9 @@ int main(int argc, char* argv[]) {
 	// print help
 	if (_print_help) {
 		LOG(LOG_INFO,
-				"\n*Standalone version usage: alarm_fingerprints_2 [parameters] < inputfile");
+				"\n*Standalone version usage: alarm_fingerprints_2 [parameters] < inputfile"
+				"\n*                       or: alarm_fingerprints_2 [parameters] -F inputfile"
+				"\n*  conversion to binary: alarm_fingerprints_2 -C binaryfile < inputfile");
 	}
 
 	// print arguments
@@ -586,6 +928,52 @@ int main(int argc, char* argv[]) {
 						+ "   (string)\n" + "*(-p) fingerprints_directory='"
 						+ _fingerprints_directory
 						+ "'   (string, './' means 'current directory')\n"
+						+ "*(-F) input_file='" + _input_file
+						+ "'   (string, empty means standard input, text or binary format)\n"
+						+ "*(-C) convert_file='" + _convert_file
+						+ "'   (string, if set, input is only converted to this binary format file)\n"
+						+ "*(-N) columns=" + std::to_string(_columns)
+						+ "   (integer, number of value columns, should be >= 1)\n"
+						+ "*(-T) follow_input=" + std::to_string(_follow_input)
+						+ "   (integer, 0 (read once), 1 (read and follow) or 2 (follow new data only) )\n"
+						+ "*(-U) async_reads=" + std::to_string(_async_reads)
+						+ "   (integer, 0 (memory mapped/sequential input) or number of reads in flight)\n"
+						+ "*(-B) block_size=" + std::to_string(_block_size)
+						+ "   (integer, 0 (no block mode) or number of records in block)\n"
+						+ "*(-Q) quiet_skip=" + std::to_string(_quiet_skip)
+						+ "   (integer, 0 (no skip-scan) or records in summary of block mode)\n"
+						+ "*(-O) max_windows=" + std::to_string(_max_windows)
+						+ "   (integer, 1 (wait while pattern collected) or max. concurrent patterns)\n"
+						+ "*(-S) stream_transform=" + std::to_string(_stream_transform)
+						+ "   (integer, 0 (after pattern end) or 1 (while pattern collected))\n"
+						+ "*(-E) early_decision=" + std::to_string(_early_decision)
+						+ "   (integer, 0 or 1 (decision before pattern end when bounds decide))\n"
+						+ "*(-D) detector=" + std::to_string(_detector)
+						+ "   (integer, 0 (differences) or 1 (wavelet details energy))\n"
+						+ "*(-A) baseline=" + std::to_string(_baseline)
+						+ "   (integer, 0 (average) or 1 (streaming median) of noise level)\n"
+						+ "*(--from) from='" + _from
+						+ "'   (string, timestamp, empty means start of input)\n"
+						+ "*(--to) to='" + _to
+						+ "'   (string, timestamp, empty means end of input)\n"
+						+ "*(--lead-in) lead_in_sec=" + std::to_string(_lead_in_sec)
+						+ "   (integer, should be >= 0)\n"
+						+ "*(--build-index) index_interval_sec="
+						+ std::to_string(_index_interval_sec)
+						+ "   (integer, 0 (no index built) or >= 1)\n"
+						+ "*(--pre-trigger) pre_trigger=" + std::to_string(_pre_trigger)
+						+ "   (integer, should be >= 0 and < fingerprint_length)\n"
+						+ "*(--checkpoint) checkpoint_file='" + _checkpoint_file
+						+ "'   (string, empty means no checkpoint of detector state)\n"
+						+ "*(--checkpoint-interval) checkpoint_interval_sec="
+						+ std::to_string(_checkpoint_interval_sec)
+						+ "   (integer, seconds of input time, should be >= 1)\n"
+						+ "*(--resume) resume=" + std::to_string(_resume)
+						+ "   (integer, 0 or 1 (present, state restored from checkpoint_file))\n"
+						+ "*(--lifting) lifting=" + std::to_string(_lifting)
+						+ "   (integer, 0 or 1 (present, patterns transformed by lifting steps))\n"
+						+ "*(--check-lifting) check_lifting=" + std::to_string(_check_lifting)
+						+ "   (integer, 0 or 1 (present, lifting compared on fingerprints of -p, then exit))\n"
 						+ "*(-d) debug_level=" + std::to_string(_debug_level)
 						+ "   (integer, should be 0, 1 or 2)\n" + "*"
 						+ std::string(116, '=');
@@ -660,6 +1048,25 @@ int main(int argc, char* argv[]) {
 							+ std::to_string(_fingerprint_match_negatives_to));
 	}
 
+	// amend _pre_trigger
+	if (_pre_trigger > _fingerprint_length - 1) {
+		_pre_trigger = _fingerprint_length - 1;
+		if (_debug_level)
+			LOG(LOG_WARNING,
+					"*WARNING: Based on fingerprint_length, pre_trigger amended to "
+							+ std::to_string(_pre_trigger));
+	}
+
+	if (_lifting) {
+		_wav_func = af_lift_transform_func(_wavelet_function);
+		if (_stream_transform && _debug_level)
+			LOG(LOG_WARNING,
+					"*WARNING: lifting (--lifting) not used by stream_transform (-S 1)");
+	}
+
+	if (_check_lifting)
+		return _check_lifting_bank();
+
 	// processing start //////////////////////////////////////////////////////////////
 
 	// set precision to double (mainly for fingerprints file generating)
@@ -681,78 +1088,274 @@ int main(int argc, char* argv[]) {
 	_isalarm = 0;
 	_iswait = 0;
 	_numthresholded = _number_of_points_to_alarm;
-	_lasttime = { 2147483646, 0 }; // large enough
+	_lasttime = 2147483646LL * 1000000; // large enough
 	_curtime = _lasttime;
-	_alarmraisetime = { 0, 0 };    // small enough
+	_alarmraisetime = 0;    // small enough
+	af_time_cache_reset(_tcache);
 
-	_genpattern_time = { 0, 0 };
+	_genpattern_time = 0;
 	_genpattern_count = 0;
 
 	// variable to count number of input lines
 	_lineid = 0;
+	_malformed_lines = 0;
 
 	_diff = 0; // difference from previous value, absolute value
 	_diffnoabs = 0; // noabsvalue
 
 	// patterns related variables
 	_patternid = 0;
-	_ispattern = 0; 	// status variable for pattern tracking
-	_patterncount = 0; 	// counts current pattern length
+	_ispattern = 0; 	// number of patterns being collected
+	_windows.resize(_max_windows);
+	_dwt.clear();
+	if (_stream_transform)
+		_dwt.resize(_columns * _max_windows);	// allocated when used first
+	_windowlost = false;
+	_lost_windows = 0;
 	_ismatch = 0;		// variable indicating final match
 	_numberfps = 0; // "real" counter of fingerprints
 
 	_matchdistance_out = -1;
 	_contivalue = 0;
 
-	//////////////////////////////////////////
-	// load negative and positive fingerprints
-	//
-	// filename p_xxxxxxx.fprxxxx holds positives, x is any or none character
-	// filename n_xxxxxxx.fprxxxx holds negatives, x is any or none character
-	//////////////////////////////////////////
-
-	// construct list of potential filenames to _patfilenames vector
-	_matchstr1 = "p_.*\\.fpr.*";
-	_matchstr2 = "n_.*\\.fpr.*";
-
-	if ((_dir = opendir(&_fingerprints_directory[0])) != NULL) {
-		if (_debug_level) {
-			_lmessage =
-					"\n*Searching for fingerprint patterns, patterns bank expected in directory '"
-							+ _fingerprints_directory + "':";
-			LOG(LOG_INFO, _lmessage);
-		}
-		while ((_ent = readdir(_dir)) != NULL) {
-			_hstr = _ent->d_name;
-			if (std::regex_match(_hstr, _matchstr1)
-					|| std::regex_match(_hstr, _matchstr2)) {
-				if (_debug_level) {
-					// debug
-					//std::cocurrentut << "(debug) type of: " << typeid(ent->d_name).name() << std::endl;
-					_lmessage = "*Filename '" + _hstr
-							+ "' found in patterns bank";
-					LOG(LOG_INFO, _lmessage);
-				}
+	// multi column input: each column starts with the initial state
+	_column = 0;
+	_curvals.assign(_columns, 0.0);
+	// last rows for patterns (window ends one row before the current one,
+	// differences need one more row)
+	af_ring_init(_ring, _columns, _fingerprint_n + 2);
+	_seqdata.assign(_fingerprint_n, 0.0);
+	_vwbuf.assign(_fingerprint_n, 0.0);
+	_wavscratch.assign(_fingerprint_n, 0.0);
+	if (_columns > 1) {
+		af_engine_init(_engine, _columns, _max_windows);
+		for (int i = 0; i < _columns; i++)
+			_channel_store(i);
+	}
 
-				// store filename
-				_patfilenames.push_back(_hstr);
-			}
-		}
-		closedir(_dir);
-	} else {
+	_latency_max = _latency_sum = _latency_count = 0;
+	_checkpoint_next = LLONG_MIN;
+
+	// time range
+	_from_time = _to_time = _start_time = 0;
+	_warmup_count = 0;
+	if ((!_from.empty()
+			&& !af_parse_timestamp(af_trim( { _from.data(), _from.size() }),
+					_tcache, _from_time))
+			|| (!_to.empty()
+					&& !af_parse_timestamp(af_trim( { _to.data(), _to.size() }),
+							_tcache, _to_time))) {
 		DLOG(LOG_ERROR,
-				"Cannot open directory '" + _fingerprints_directory
-						+ "' for patterns (may verify -p parameter)\nExiting");
-#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
+				"\nfrom/to (--from, --to) must be timestamps dd-mm-yyyy hh:mm:ss[.usec]\nExiting");
 		return 1;
-#else
-		{
-			//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
-		}
-#endif
 	}
+	_start_time = _from_time - (long long) _lead_in_sec * 1000000;
+	af_time_cache_reset(_tcache);
+	_infd = -1;
+	_compressed_input = AF_DECOMP_NONE;
+
+	// open input: memory mapped file (text or binary format), followed file or stdin
+	pos = 0;
+	_binary_input = 0;
+	_linecount = 0;
+	if (_follow_input) {
+		if (_input_file.empty() || !_convert_file.empty()) {
+			DLOG(LOG_ERROR,
+					"\nfollow_input (-T) requires input file (-F) and no conversion (-C)\nExiting");
+			return 1;
+		}
+		if (af_follow_open(_infollow, _input_file, _follow_input == 2)) {
+			DLOG(LOG_ERROR,
+					"Cannot open input file '" + _input_file
+							+ "' (may verify -F parameter)\nExiting");
+			return 1;
+		}
+		af_text_open_source(_intext, &af_follow_read, &_infollow);
 
-	// finish if too much _patfilenames
+		// following ends normally (incl. summary) on interrupt
+		signal(SIGINT, &_follow_signal);
+		signal(SIGTERM, &_follow_signal);
+
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*Following input file '" + _input_file + "'");
+	} else if (_async_reads && (_infd = _open_async_input()) >= 0) {
+		af_text_open_source(_intext, &af_uring_read, &_inuring);
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*Input read by " + std::string(af_uring_name(_inuring))
+							+ ", reads in flight: "
+							+ std::to_string(_inuring.depth));
+	} else if (!_input_file.empty()) {
+		if (af_mmap_open(_inmap, _input_file)) {
+			DLOG(LOG_ERROR,
+					"Cannot open input file '" + _input_file
+							+ "' (may verify -F parameter)\nExiting");
+#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
+			return 1;
+#else
+			{
+				//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
+			}
+#endif
+		}
+
+		if (af_bin_is_binary(_inmap.data, _inmap.size)) {
+			if (af_bin_open(_inbin, _inmap.data, _inmap.size)
+					|| (int) _inbin.h.columns != _columns) {
+				DLOG(LOG_ERROR,
+						"Unsupported binary input file '" + _input_file
+								+ "' (may verify -N parameter)\nExiting");
+#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
+				return 1;
+#else
+				{
+					//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
+				}
+#endif
+			}
+			_binary_input = 1;
+
+			// header lines of the source text file are counted by sampling as before
+			for (unsigned int i = 0; i < _inbin.h.lead_lines; i++)
+				if (_cursample-- <= 1)
+					_cursample = _sample_each;
+
+			if (_debug_level)
+				LOG(LOG_INFO,
+						"\n*Binary input file '" + _input_file + "' with "
+								+ std::to_string(_inbin.h.records)
+								+ " records");
+		} else if (af_decomp_format(_inmap.data, _inmap.size)
+				!= AF_DECOMP_NONE) {
+			if (_open_compressed(_inmap.data, _inmap.size, -1))
+				return 1;
+		} else {
+			pos = _seek_input();
+			af_text_open_memory(_intext, _inmap.data + pos, _inmap.size - pos);
+		}
+	} else if (_open_stdin())
+		return 1;
+	_in_header = 1;
+
+	// timestamp index of input file only (--build-index)
+	if (_index_interval_sec) {
+		if (_inmap.data == NULL || _binary_input || _compressed_input
+				|| pos != 0) {
+			DLOG(LOG_ERROR,
+					"\nbuild-index requires text input file (-F), not compressed, without --from\nExiting");
+			return 1;
+		}
+		co = af_index_create(_input_file, _inmap.data, _inmap.size,
+				(long long) _index_interval_sec * 1000000);
+		if (co < 0) {
+			DLOG(LOG_ERROR,
+					"Cannot create index file '" + af_index_name(_input_file)
+							+ "'\nExiting");
+			return 1;
+		}
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*Index file '" + af_index_name(_input_file)
+							+ "' created, entries: " + std::to_string(co));
+		_close_input();
+		return 0;
+	}
+
+	// conversion of input to binary format file only (-C)
+	if (!_convert_file.empty()) {
+
+		// all records converted, sampling is applied when binary file is processed
+		_sample_each = 1;
+		_cursample = 1;
+
+		if (af_bin_create(_binout, _convert_file, _columns, 0)) {
+			DLOG(LOG_ERROR,
+					"Cannot create binary file '" + _convert_file
+							+ "' (may verify -C parameter)\nExiting");
+			return 1;
+		}
+
+		while (_next_record()) {
+			if (_binout.h.records == 0 && _binout.ts.empty())
+				_binout.h.lead_lines =
+						_binary_input ? _inbin.h.lead_lines : _linecount - 1;
+			if (af_bin_append(_binout, _curtime,
+					_columns == 1 ? &_curval : &_curvals[0]))
+				break;
+		}
+
+		if (af_bin_close(_binout)) {
+			DLOG(LOG_ERROR,
+					"Error writing binary file '" + _convert_file
+							+ "'\nExiting");
+			return 1;
+		}
+
+		if (_debug_level) {
+			LOG(LOG_INFO,
+					"\n*Input converted to binary file '" + _convert_file
+							+ "', records: "
+							+ std::to_string(_binout.h.records));
+			if (_malformed_lines)
+				LOG(LOG_WARNING,
+						"*WARNING: " + std::to_string(_malformed_lines)
+								+ " malformed input line(s) skipped");
+		}
+
+		_close_input();
+		return 0;
+	}
+
+	//////////////////////////////////////////
+	// load negative and positive fingerprints
+	//
+	// filename p_xxxxxxx.fprxxxx holds positives, x is any or none character
+	// filename n_xxxxxxx.fprxxxx holds negatives, x is any or none character
+	//////////////////////////////////////////
+
+	// construct list of potential filenames to _patfilenames vector
+	_matchstr1 = "p_.*\\.fpr.*";
+	_matchstr2 = "n_.*\\.fpr.*";
+
+	if ((_dir = opendir(&_fingerprints_directory[0])) != NULL) {
+		if (_debug_level) {
+			_lmessage =
+					"\n*Searching for fingerprint patterns, patterns bank expected in directory '"
+							+ _fingerprints_directory + "':";
+			LOG(LOG_INFO, _lmessage);
+		}
+		while ((_ent = readdir(_dir)) != NULL) {
+			_hstr = _ent->d_name;
+			if (std::regex_match(_hstr, _matchstr1)
+					|| std::regex_match(_hstr, _matchstr2)) {
+				if (_debug_level) {
+					// debug
+					//std::cocurrentut << "(debug) type of: " << typeid(ent->d_name).name() << std::endl;
+					_lmessage = "*Filename '" + _hstr
+							+ "' found in patterns bank";
+					LOG(LOG_INFO, _lmessage);
+				}
+
+				// store filename
+				_patfilenames.push_back(_hstr);
+			}
+		}
+		closedir(_dir);
+	} else {
+		DLOG(LOG_ERROR,
+				"Cannot open directory '" + _fingerprints_directory
+						+ "' for patterns (may verify -p parameter)\nExiting");
+#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
+		return 1;
+#else
+		{
+			//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
+		}
+#endif
+	}
+
+	// finish if too much _patfilenames
 	if (_patfilenames.size() > MAX_FINGEPRINTS_TO_LOAD) {
 		DLOG(LOG_ERROR, "Too many files with pattern-like name found\nExiting");
 #ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
@@ -769,6 +1372,8 @@ int main(int argc, char* argv[]) {
 	if (_patfilenames.size() > 0) {
 
 		std::string linefile; // helper for reads
+		af_span linespan; // helper for parsing of read line
+		double linevalue; // helper for parsed value
 		std::string fn; // helper for file name
 		std::string patname; // helper for patterns name
 
@@ -807,16 +1412,15 @@ int main(int argc, char* argv[]) {
 				}
 
 				while (std::getline(lfpfile, linefile)) {
-					try {
-
-						// debug
-						// std::cout << "(debug) push_back: " << std::stod(linefile) << std::endl;
-						// std::cout << "(debug) push_back to i: " << i << std::endl;
-						// std::cout << "(debug) current size _fngpts[i]: " << _fngpts[i].size() << std::endl;
 
-						_fngpts[i].push_back(std::stod(linefile));
+					// debug
+					// std::cout << "(debug) push_back: " << linefile << std::endl;
+					// std::cout << "(debug) push_back to i: " << i << std::endl;
+					// std::cout << "(debug) current size _fngpts[i]: " << _fngpts[i].size() << std::endl;
 
-					} catch (const std::exception &exc) {
+					linespan.b = linefile.c_str();
+					linespan.n = linefile.size();
+					if (!af_parse_double(linespan, linevalue)) {
 						DLOG(LOG_ERROR,
 								"Error reading fingerprint file "
 										+ _patfilenames[i] + "\nLine: "
@@ -830,6 +1434,8 @@ int main(int argc, char* argv[]) {
 						}
 #endif
 					}
+
+					_fngpts[i].push_back(linevalue);
 				}
 
 				lfpfile.close();
@@ -899,6 +1505,56 @@ int main(int argc, char* argv[]) {
 			LOG(LOG_INFO, "*No patterns found in bank for load");
 	}
 
+	// early decision: bank patterns of matching logic (all items to compare present)
+	_early = _early_decision && _stream_transform
+			&& _distance_calculation_type == 1
+			&& (_matches_evaluation_logic == 1 || _matches_evaluation_logic == 2);
+	_early_bank.clear();
+	for (int i = 0; _early && i < _numberfps; i++) {
+		if (_fngptsnames[i].substr(0, 1)
+				!= (_matches_evaluation_logic == 1 ? "n" : "p"))
+			continue;
+		if (_fngpts[i].size()
+				<= (unsigned int) (_matches_evaluation_logic == 1 ?
+						_fingerprint_match_negatives_to :
+						_fingerprint_match_positives_to))
+			_early = false;
+		else
+			_early_bank.push_back(&_fngpts[i][0]);
+	}
+	if (_early_decision && !_early && _debug_level)
+		LOG(LOG_WARNING,
+				"*WARNING: early_decision (-E) not used, needs stream_transform 1, "
+						"distance_calculation_type 1, matches_evaluation_logic 1 or 2 "
+						"and bank patterns of fingerprint_length");
+	_partial.clear();
+	if (_early)
+		_partial.resize(_dwt.size());
+
+	// wavelet energy detector of each column
+	_wdet.clear();
+	if (_detector) {
+		_wdet.resize(_columns);
+		for (int i = 0; i < _columns; i++)
+			af_wdet_init(_wdet[i], _wavelet_function);
+	}
+
+	// median baseline estimator of each column
+	_median.clear();
+	if (_baseline == AF_BASELINE_MEDIAN) {
+		_median.resize(_columns);
+		for (int i = 0; i < _columns; i++)
+			af_median_init(_median[i], _initial_avg_diff, _n_amend_avgdiff);
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*Noise level estimated by "
+							+ std::string(af_baseline_name(_baseline)));
+	}
+
+	// warm restart: state of the previous run
+	if (_resume && _restore())
+		return 1;
+
 	// output header in debug > 1
 
 	if (_debug_level)
@@ -907,634 +1563,1609 @@ int main(int argc, char* argv[]) {
 	if (_debug_level > 1) {
 		LOG(LOG_INFO,
 				"*" + std::string(117, '=')
-						+ "\nlineid;timestamp;meas;diff;diffavg;isdetect;isalarm;iswait;patternid;isfinalmatch;matchdistance;contivalue;outputvalue");
+						+ (_columns == 1 ? "\nlineid;" : "\nlineid;column;")
+						+ "timestamp;meas;diff;diffavg;isdetect;isalarm;iswait;patternid;isfinalmatch;matchdistance;contivalue;outputvalue");
 	}
 
-	while (std::getline(std::cin, _lineread)) {
-
-		// debug output: copy of input line
-		// std::cout << std::endl << _lineread << std::endl;
-
-		// sampling?
-		if (_cursample-- > 1) {
+	// block mode reads all input, the loop below then ends immediately
+	if (_block_size && _columns == 1 && !_follow_input && _from.empty()
+			&& _to.empty() && _debug_level < 2 && !_detector && !_baseline
+			&& _run_blocks())
+		return 1;
 
-			// debug
-			// std::cout << "previous line sampled out" << std::endl;
-			continue;
-		} else
-			_cursample = _sample_each;
+	while (_next_record()) {
 
-		// patch: tries to skip "standard" heading lines containing certain character
-		if (_lineread.find(_skip_if_contains) != std::string::npos) {
-			// debug
-			// std::cout << "(debug) skipped line" << std::endl;
+		// time range: records before lead-in skipped, lead-in records warm up detector
+		if (!_to.empty() && _curtime > _to_time)
+			break;
+		if (!_from.empty() && _curtime < _from_time) {
+			if (_curtime >= _start_time)
+				_warm_up();
 			continue;
 		}
+		if (_lineid == 0 && !_from.empty() && _debug_level)
+			LOG(LOG_INFO,
+					"*Detector warmed up by " + std::to_string(_warmup_count)
+							+ " lead-in record(s)");
 
-		// parses input line
-		pos = _lineread.find(';');
+		// increments lineid (one per processed input line)
+		_lineid++;
+		af_ring_push(_ring, _columns == 1 ? &_curval : &_curvals[0]);
 
-		// skips if not found ';'
-		if (pos == std::string::npos)
-			continue;
+		// single value column, processed directly in working variables
+		if (_columns == 1) {
+			if (_process_sample())
+				return 1;
+		}
 
-		_p1 = trim(_lineread.substr(0, pos)); // parse and trim first before ;, i.e. timestamp
-		_p2 = trim(_lineread.erase(0, pos + 1)); // parse and trim measured value
+		// more value columns, each with own detector and pattern state
+		// (all processed by scalar code if per line output is required,
+		// with wavelet energy detector or median baseline)
+		else if (_debug_level > 1 || _detector || _baseline) {
+			for (int i = 0; i < _columns; i++)
+				if (_process_column(i))
+					return 1;
+		}
 
-		// convert string to char to be used by sscanf
-		c = &_p1[0];
+		// noise level of quiet columns amended in one pass, only columns
+		// crossing the threshold or in alarm/pattern state processed one by one
+		else {
+			_lasttime = _curtime;
+			_nscalar = af_engine_tick(_engine, &_curvals[0],
+					_multiplicator_to_detect, _n_amend_avgdiff);
+			for (int i = 0; i < _nscalar; i++)
+				if (_process_column(_engine.scalar[i]))
+					return 1;
+		}
 
-		// parse using sscanf
-		// e.g. 10-03-2016 15:19:20.729915
-		sscanf(c, "%d-%d-%d %d:%d:%d.%d", &d, &m, &y, &h, &mi, &s, &ms);
+		if (!_checkpoint_file.empty() && _checkpoint(false))
+			return 1;
 
-		// fill current time
-		t.tm_year = y - 1900;
-		t.tm_mon = m;
-		t.tm_mday = d;
-		t.tm_hour = h;
-		t.tm_min = mi;
-		t.tm_sec = s;
-		_curtime.tv_sec = mktime(&t);
-		_curtime.tv_usec = ms;
+	} // of input values cycle while
 
-		_lasttime = _curtime;
+	// final state for warm restart
+	if (!_checkpoint_file.empty() && _lineid > 0 && _checkpoint(true))
+		return 1;
 
-		// take current value to _curval
-		_curval = std::stod(_p2);
+	if (_columns > 1)
+		af_engine_free(_engine);
 
-		// increments lineid and copies last values for the first line
-		if (!_lineid++)
-			_lastval = _curval;
+	_close_input();
 
-		// calculate diff as abs value
-		_diffnoabs = _curval - _lastval;
-		_diff = fabs(_diffnoabs);
+	if (_debug_level && _malformed_lines)
+		LOG(LOG_WARNING,
+				"*WARNING: " + std::to_string(_malformed_lines)
+						+ " malformed input line(s) skipped");
 
-		// pattern evaluation
-		if (_ispattern == 1) {
+	if (_debug_level && _lost_windows)
+		LOG(LOG_WARNING,
+				"*WARNING: " + std::to_string(_lost_windows)
+						+ " alarm(s) without pattern (all max_windows in use)");
 
-			// is in "pattern" state - push noabs diff or meas based on use_diff_value
-			if (_use_diff_value)
-				_seqdata.push_back(_diffnoabs);
-			else
-				_seqdata.push_back(_curval);
+	if (_debug_level && _blockquiet)
+		LOG(LOG_INFO,
+				"\n*Block mode: " + std::to_string(_blockquiet) + " of "
+						+ std::to_string(_lineid)
+						+ " records proven quiet"
+						+ (_quiet_skip ?
+								", " + std::to_string(_blockskipped)
+										+ " in blocks skipped by summary" :
+								""));
+
+	if (_follow_input) {
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*Following ended, file rotations: "
+							+ std::to_string(_infollow.rotations)
+							+ ", truncations: "
+							+ std::to_string(_infollow.truncations)
+							+ ", decisions: " + std::to_string(_latency_count)
+							+ ", latency avg/max (usec): "
+							+ std::to_string(
+									_latency_count ?
+											_latency_sum / _latency_count : 0)
+							+ "/" + std::to_string(_latency_max));
+		af_follow_close(_infollow);
+	}
 
-			// debug
-			// std::cout << "pattern recognition" << std::endl;
-			// std::cout << "_patterncount: " << _patterncount << std::endl;
+	return 0;
+}
 
-			if (--_patterncount <= 0) {
-				// pattern end, process _seqdata
-				_dw = &_seqdata[0];
+/*****************************************************************************
+ * functions definitions
+ *****************************************************************************/
 
-				//debug
-				//std::cout << "Input data for wavelet:\n";
-				//for (int i = 0; i < _fingerprint_n; i++ )
-				//	std::cout << _dw[i] << std::endl;
+// trim string
+std::string trim(const std::string& str) {
+	size_t first = str.find_first_not_of(' ');
+	if (std::string::npos == first) {
+		return str;
+	}
+	size_t last = str.find_last_not_of(' ');
+	return str.substr(first, (last - first + 1));
+}
 
-				// find fingerprint (uses pointer to wavelet function)
-				_vw = (*_wav_func)(_fingerprint_n, _dw);
+// processes current measurement (_curtime, _curval) in working variables:
+// alarm detection, pattern collection and matching, fingerprint generation
+// returns non zero on fatal error
+int _process_sample() {
 
-				// write fingerprint to log
-				if (_debug_level > 1) {
-					LOG(LOG_INFO,
-							"*Measurements for actual pattern collected, calculated fingerprint:");
-					_lmessage = "*";
-					for (unsigned int j = 0; j < _seqdata.size() - 1; j++)
-						_lmessage = _lmessage + std::to_string(_vw[j]) + " ";
-					LOG(LOG_INFO, _lmessage);
-				}
 
-				// if patterns for comparison exist, do matching between
-				// current pattern i _vw and all patterns where:
-				// _numberfps - number of loaded patterns
-				// _fngpts - vector of vectors of loaded patterns
-				// _fngptsnames - vector of loaded patterns names
-				//              (_n.... for negatives or _p.... for positives)
-				// matches_evaluation_logic drives how patterns are matched
+	// timestamp text needed only for messages and fingerprint file names
+	if (_debug_level || _ispattern) {
+		if (_binary_input)
+			af_format_timestamp(_curtime, _p1);
+		else
+			_p1.assign(_ts.b, _ts.n);
+	}
 
-				if (_debug_level) {
+	_lasttime = _curtime;
 
-					// only if some patterns loaded
-					if (_numberfps) {
-						_lmessage =
-								"*Matching collected measurements pattern with patterns loaded"
-										" from bank (matching logic="
-										+ std::to_string(
-												_matches_evaluation_logic)
-										+ "):";
-						LOG(LOG_INFO, _lmessage);
-					}
+	// copies last values for the first line (last lead-in value if any)
+	if (_lineid == 1 && _warmup_count == 0)
+		_lastval = _curval;
 
-				}
+	// calculate diff as abs value
+	_diffnoabs = _curval - _lastval;
+	_diff = _detector ?
+			af_wdet_next(_wdet[_column], _curval) : fabs(_diffnoabs);
 
-				_pos_count = 0;
-				_matchpos_count = 0;
-				_neg_count = 0;
-				_matchneg_count = 0;
-				_matchdistance_pos_min = 1; // initial max value
-				_matchdistance_neg_min = 1; // initial max value
-
-				// evaluate positives if necessary
-				if (_matches_evaluation_logic == 2
-						|| _matches_evaluation_logic == 3
-						|| _matches_evaluation_logic == 4) {
-
-					// try to match EACH negative match
-					for (int i = 0; i < _numberfps; i++) {
-						if (_fngptsnames[i].substr(0, 1) == "p") {
-
-							_pos_count++;
-
-							// calculate distance using parameters
-							_matchdistance = _eucl_dist(_vw, &_fngpts[i][0],
-									_fingerprint_match_positives_from,
-									_fingerprint_match_positives_to,
-									_fingerprint_length,
-									_distance_calculation_type);
-
-							// amend min found positive distances
-							if (_matchdistance < _matchdistance_pos_min)
-								_matchdistance_pos_min = _matchdistance;
-
-							if (_debug_level) {
-								_lmessage =
-										"*Actual pattern no "
-												+ std::to_string(_patternid)
-												+ " and positive bank pattern '"
-												+ _fngptsnames[i]
-												+ "', matching items "
-												+ std::to_string(
-														_fingerprint_match_positives_from)
-												+ ".."
-												+ std::to_string(
-														_fingerprint_match_positives_to)
-												+ ", threshold="
-												+ std::to_string(
-														_matching_distance_positives_max)
-												+ ", match distance is "
-												+ std::to_string(_matchdistance)
-												+ "  "
-												+ ((_matchdistance
-														<= _matching_distance_positives_max) ?
-														"* individual match *" :
-														"* no individual match *");
-								LOG(LOG_INFO, _lmessage);
-							}
-
-							// match (first positive match is enough)
-							if (_matchdistance
-									<= _matching_distance_positives_max) {
-
-								_matchpos_count++;
-								_matchtestposname = _fngptsnames[i];
-
-							}
-						}
+	// pattern evaluation
+	if (_ispattern) {
 
-						// break for loop if any positive when evaluation logic 2
-						// continuing in evaluation when evaluation logic 3 or 4
-						if (_matchpos_count
-								&& (_matches_evaluation_logic == 2
-										|| _matches_evaluation_logic == 3))
-							break;
-					}
+		// is in "pattern" state - values (noabs diff or meas based on use_diff_value)
+		// are kept in the ring
 
-				}
+		// debug
+		// std::cout << "pattern recognition" << std::endl;
+		// std::cout << "_ispattern: " << _ispattern << std::endl;
+
+		// windows complete in order of their start
+		for (int w = 0; w < _ispattern;) {
+			if (--_windows[w].count > 0) {
+				if (_windows[w].dwt >= 0)
+					af_dwt_push(_dwt[_windows[w].dwt],
+							_use_diff_value ? _diffnoabs : _curval);
+				if (_early && !_windows[w].early)
+					_decide_early(_windows[w]);
+
+				// decided, collected further only for fingerprint generation
+				if (_windows[w].early && _generate_fingerprints != 1
+						&& !(_generate_fingerprints == 2
+								&& _windows[w].early == -1))
+					_end_window(w);
+				else
+					w++;
+				continue;
+			}
+			if (_evaluate_pattern(_windows[w]))
+				return 1;
+			_end_window(w);
+		}
 
-				// evaluate negatives (if necessary)
-				if (_matches_evaluation_logic == 1
-						|| _matches_evaluation_logic == 3) {
-
-					// try to match EACH negative match
-					for (int i = 0; i < _numberfps; i++) {
-						if (_fngptsnames[i].substr(0, 1) == "n") {
-
-							_neg_count++;
-
-							// calculate distance using parameters
-							_matchdistance = _eucl_dist(_vw, &_fngpts[i][0],
-									_fingerprint_match_negatives_from,
-									_fingerprint_match_negatives_to,
-									_fingerprint_length,
-									_distance_calculation_type);
-
-							if (_matchdistance < _matchdistance_neg_min)
-								_matchdistance_neg_min = _matchdistance;
-
-							// debug
-							//std::cout << "(debug) matchdistance: " << _matchdistance << std::endl;
-
-							if (_matchdistance
-									<= _matching_distance_negatives_max) {
-
-								_matchneg_count++;
-							}
-
-							if (_debug_level) {
-
-								_lmessage =
-										"*Actual pattern no "
-												+ std::to_string(_patternid)
-												+ " and negative bank pattern '"
-												+ _fngptsnames[i]
-												+ "', matching items "
-												+ std::to_string(
-														_fingerprint_match_negatives_from)
-												+ ".."
-												+ std::to_string(
-														_fingerprint_match_negatives_to)
-												+ ", threshold="
-												+ std::to_string(
-														_matching_distance_negatives_max)
-												+ ", match distance is "
-												+ std::to_string(_matchdistance)
-												+ "  "
-												+ ((_matchdistance
-														<= _matching_distance_negatives_max) ?
-														"* individual match *" :
-														"* no individual match *");
-								LOG(LOG_INFO, _lmessage);
-							}
+	} // of _ispattern
 
-						}
-					}
+	//
+	// debug
+	//std::cout << "(debug) _ispattern: " << _ispattern << std::endl;
 
-				}
+	// impute wait state, even if currently not present
 
-				// final evaluation using evaluation logic
-
-				// prepare match comment
-				_match_comment =
-						"***Final match raised for measurements pattern no "
-								+ std::to_string(_patternid) + " at " + _p1
-								+ "\n***";
-
-				// default is nonmatch
-				_ismatch = 0;
-				_matchdistance_out = -1;  // default is "no match"
-				_contivalue = 0; // default is "no suspection"
-
-				switch (_matches_evaluation_logic) {
-
-				// If _matches_evaluation_logic = 0, no fingerprints matching is provided at all
-				case 0:
-					_ismatch = 1; // pure "alarm_noisereject + pattern related delay" like
-					_contivalue = 1;
-					_match_comment =
-							_match_comment
-									+ "Logic 0 (pure alarm_noisereject-like without bank patterns matching)";
-					break;
-
-					// If _matches_evaluation_logic = 1, not matching any negative pattern causes to raise match
-				case 1:
-					// _contivalue set even when not match
-					_contivalue = _matchdistance_neg_min;
-
-					// match logic
-					if (_matchneg_count == 0) {
-						_ismatch = 1;  // no negative pattern matched
-						_matchdistance_out = _matchdistance_neg_min;
-						_match_comment =
-								_match_comment
-										+ "Logic 1 (final match raised because no individual match for negative bank patterns raised)";
-					}
-					break;
-
-					// If _matches_evaluation_logic = 2, matching any positive pattern causes raise match
-				case 2:
-					// _contivalue set even when not match
-					_contivalue = 1 - _matchdistance_pos_min;
-
-					// match logic
-					if (_matchpos_count) {
-						_ismatch = 1;  // some new pattern
-						_matchdistance_out = _matchdistance_pos_min;
-						_match_comment =
-								_match_comment
-										+ "Logic 2 (final match raised because bank pattern '"
-										+ _matchtestposname
-										+ "' raised an individual match)";
-					}
-					break;
-
-					// If _matches_evaluation_logic = 3, not matching any negative patterns and matching any positive
-				case 3:
-
-					// _contivalue set even when not match
-					_contivalue = _matchdistance_neg_min;
-					if (_matchdistance_pos_min < _matchdistance_neg_min)
-						_contivalue = _matchdistance_pos_min;
-					_contivalue = 1 - _contivalue;
-
-					// match logic
-					if (_matchneg_count == 0 && _matchpos_count > 0) {
-						_ismatch = 1;  // some new pattern
-
-						// minimum distance from positives or negatives
-						_matchdistance_out = _matchdistance_neg_min;
-						if (_matchdistance_pos_min < _matchdistance_out)
-							_matchdistance_out = _matchdistance_pos_min;
-
-						_match_comment =
-								_match_comment
-										+ "Logic 3 (final match raised because no negative bank pattern individual match raised and positive bank pattern '"
-										+ _matchtestposname
-										+ "' raised an individual match)";
-					}
-					break;
-
-					// If _matches_evaluation_logic = 4, matching all positive patterns
-				case 4:
-					// _contivalue set even when not match
-					_contivalue = 1 - _matchdistance_pos_min;
-
-					// match logic
-					if (_matchpos_count) {
-						_ismatch = 1;  // some new pattern
-						_matchdistance_out = _matchdistance_pos_min;
-						_match_comment =
-								_match_comment
-										+ "Logic 4 (final match raised because "
-										+ std::to_string(_matchpos_count)
-										+ " positive bank pattern(s) raised individual match)";
-					}
-					break;
+	//verify if waiting period after previously detected alarm
+	if (_iswait == 1) {
 
-				default: {
-					DLOG(LOG_ERROR,
-							"\nError\nUnknown evaluation logic "
-									+ std::to_string(_matches_evaluation_logic)
-									+ "\nExiting");
-#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
-					return 1;
-#else
-					{
-						//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
+		// is in "wait" state
 
-					}
-#endif
-				}
+		// after entering the wait state, reset the alarm status
+		_isalarm = 0;
 
-				} // of matches evaluation logic switch
+		// debug
+		// std::cout << "*(debug) alarmdiff: " << _curtime - _alarmraisetime << std::endl;
 
-				// debug
-				// std::cout << "(debug) _generate_fingerprints: " << _generate_fingerprints << std::endl;
-				// std::cout << "(debug) _matchpos_count: " << _matchpos_count << std::endl;
-				// std::cout << "(debug) _matchneg_count: " << _matchneg_count << std::endl;
+		if (_curtime - _alarmraisetime > _wait_state_usec)
+			_iswait = 0;		// reset wait period
 
-				// output to file, if not forbidden by generate_fingerprint logic
-				// debug
-				// std::cout << "(debug) _curtime.tv_sec: " << _curtime.tv_sec << std::endl;
-				// std::cout << "(debug) _genpattern_time.tv_sec: " << _genpattern_time.tv_sec << std::endl;
-				// std::cout << "(debug) genpattern_count: " << genpattern_count << std::endl;
-				// std::cout << "(debug) _matchpos_count: " << _matchpos_count << std::endl;
-				// std::cout << "(debug) _matchneg_count: " << _matchneg_count << std::endl;
-
-				if (_generate_fingerprints == 1
-						|| (_generate_fingerprints == 2 && !_ismatch)) {
-
-					//verify generating fingerprints throttle and shift time, if time limit passed
-					if ((_curtime.tv_sec - _genpattern_time.tv_sec) > 60 * 60) {
-						_genpattern_time = _curtime;
-						_genpattern_count = 0;
-					}
+		// force _iswait back if still patterngeneration in process
+		// (unless more patterns can be collected concurrently)
+		if (_ispattern && _max_windows == 1)
+			_iswait = 1;
 
-					if (_genpattern_hour_limit == 0
-							|| (_genpattern_count < _genpattern_hour_limit))
-
-							{
-
-						//increment counter of generated fingerprints
-						_genpattern_count++;
-
-						// find leading zeros
-						_patzeros = 0;
-						if (_patternid < 10)
-							_patzeros = 3;
-						else if (_patternid < 100)
-							_patzeros = 2;
-						else if (_patternid < 10)
-							_patzeros = 1;
-
-						std::ofstream outputfile;
-
-						// debug
-						//std::cout << "(debug) _patternid: " << _patternid << std::endl;
-						//std::cout << "(debug) _p1: " << _p1 << std::endl;
-						//std::cout << "(debug) _wavelet_function: " << _wavelet_function << std::endl;
-
-						// build pattern filename (incl. directory)
-						_filenam = "w_" + std::string(_patzeros, '0')
-								+ std::to_string(_patternid) + "_" + _p1;
-
-						//amend filename (mainly for windows) - substitute certain characters by '_' or similar
-						while (_filenam.find(":") != std::string::npos)
-							_filenam = _filenam.replace(_filenam.find(":"), 1,
-									"_");
-						while (_filenam.find("-") != std::string::npos)
-							_filenam = _filenam.replace(_filenam.find("-"), 1,
-									"_");
-						while (_filenam.find(".") != std::string::npos)
-							_filenam = _filenam.replace(_filenam.find("."), 1,
-									"_");
-						while (_filenam.find(" ") != std::string::npos)
-							_filenam = _filenam.replace(_filenam.find(" "), 1,
-									"_");
-
-						// add directory and suffix for fingerprints filename
-						_filenam = _filenam +
-						// add suffix .fpr and fingerprint parameter id
-								".fpr" + std::to_string(_wavelet_function) +
-								// add fingerprint length
-								"_len" + std::to_string(_fingerprint_n);
-						// debug
-						//std::cout << "(debug) filename of wavelets: " << _filenam << std::endl;
-
-						outputfile.open(_fingerprints_directory + _filenam);
-						for (int i = 0; i < _fingerprint_n; i++) {
-							outputfile << std::fixed << _vw[i] << std::endl;
-						}
-						outputfile.close();
+	} else {
 
-						if (_debug_level) {
-							_lmessage = "*Fingerprint saved to file: " + _filenam;
-							LOG(LOG_INFO, _lmessage);
-						}
+		// not in wait state
 
-					}
+		if (_diff < _multiplicator_to_detect * _diffavg)
+			_numthresholded = _number_of_points_to_alarm;	//reset thresholding count
+		else {
 
-					else {
-						//genpattern limit reached
+			// debug
+			// std::cout << "numthresholded: " << _numthresholded << std::endl;
 
-						if (_debug_level) {
-							_lmessage =
-									"*Fingerprint generation limit within hour reached, fingerprint not saved";
-							LOG(LOG_INFO, _lmessage);
-						}
-					}
+			// if number of subsequent points is enough, raise alarm
+			if (--_numthresholded == 0) {
+				//	number of subsequent differences found
 
-				}
+				// alarm raised
+				_isalarm = 1;
+				_alarmraisetime = _curtime;
+				_iswait = 1;
+				_numthresholded = _number_of_points_to_alarm;
 
-				// match raised here //////////////////////////////////////////////
-				if (_ismatch && _debug_level) {
-					/*****************************************************************/
-					LOG(LOG_INFO, std::string(117, '*'));
-					LOG(LOG_INFO, _match_comment);
-					LOG(LOG_INFO, std::string(117, '*'));
-					/*****************************************************************/
+				// pattern starts, _pre_trigger values before the current one included
+				_windowlost = _ispattern == _max_windows;
+				if (_windowlost)
+					_lost_windows++;
+				else {
+					_patternid++;
+					_windows[_ispattern].patternid = _patternid;
+					_windows[_ispattern].count = _fingerprint_n - _pre_trigger;
+					_windows[_ispattern].dwt = _start_transform(
+							_pre_trigger + 1);
+					_windows[_ispattern].early = 0;
+					_ispattern++;
 				}
 
-				// clear variables for next pattern
-				_seqdata.clear();
-				_ispattern = 0;
 			}
+		}
+	}
 
-		} // of _ispattern
+	// amend diffavg, use _n_amend_avgdiff
 
-		//
-		// debug
-		//std::cout << "(debug) _ispattern: " << _ispattern << std::endl;
+	// do not amend if in wait state of detection sequence based on _number_of_points_to_alarm
+	if (_iswait == 0 && _numthresholded == _number_of_points_to_alarm)
+		_amend_baseline();
 
-		// impute wait state, even if currently not present
+	// if < 1, set 1
+	// if (_diffavg < 1)
+	//	_diffavg = 1;
 
-		//verify if waiting period after previously detected alarm
-		if (_iswait == 1) {
+	// remember current value,
+	_lastval = _curval;
 
-			// is in "wait" state
+	// output special debug line if alarm detected
+	if (_debug_level && _isalarm) {
+		if (_windowlost)
+			_lmessage = "*Alarm detected at " + _p1
+					+ ", no pattern collected (max_windows patterns in collection)"
+					+ _column_text();
+		else
+			_lmessage = "*Alarm detected at " + _p1
+					+ ", collecting measurements pattern "
+					+ std::to_string(_patternid) + _column_text();
+		LOG(LOG_INFO, _lmessage);
+	}
 
-			// after entering the wait state, reset the alarm status
-			_isalarm = 0;
+	// outputvalue is either _contivalue or _matchdistance_output
 
-			// debug
-			// std::cout << "*(debug) alarmdiff: " << (_curtime.tv_sec - _alarmraisetime.tv_sec) * 1000000 + (_curtime.tv_usec - _alarmraisetime.tv_usec) << std::endl;
+	_outputvalue = _contivalue;
+	if (_matchdistance_to_output)
+		_outputvalue = _matchdistance_out;
 
-			if ((_curtime.tv_sec - _alarmraisetime.tv_sec) * 1000000 + _curtime.tv_usec - _alarmraisetime.tv_usec > _wait_state_usec)
-				_iswait = 0;		// reset wait period
+	// output debug line
+	if (_debug_level > 1) {
+		_lmessage = std::to_string(_lineid) + ";"
+				+ (_columns == 1 ? "" : std::to_string(_column + 1) + ";") + _p1
+				+ ";"
+				+ std::to_string(_curval) + ";" + std::to_string(_diffnoabs)
+				+ ";" + std::to_string(_diffavg) + ";"
+				+ (_numthresholded == _number_of_points_to_alarm ? "0" : "1")
+				+ ";" + std::to_string(_isalarm) + ";"
+				+ std::to_string(_iswait) + ";"
+				+ std::to_string(_ispattern ? _patternid : 0) + ";"
+				+ std::to_string(_ismatch) + ";"
+				+ std::to_string(_matchdistance_out) + ";"
+				+ std::to_string(_contivalue) + ";"
+				+ std::to_string(_outputvalue);
 
-			// force _iswait back if still patterngeneration in process
-			if (_ispattern)
-				_iswait = 1;
+		LOG(LOG_INFO, _lmessage);
+	}
 
-		} else {
+	//////////////////////////////////////////////////////////////////////////////////
+	// put _outputvalue to output
+	if (_debug_level && _matchdistance_out != -1) {
 
-			// not in wait state
+		//debug
+		//std::cout << "(debug) _contivalue: " << _contivalue << std::endl;
+		//std::cout << "(debug) _matchdistance__out: " << _matchdistance_out << std::endl;
 
-			if (_diff < _multiplicator_to_detect * _diffavg)
-				_numthresholded = _number_of_points_to_alarm;	//reset thresholding count
-			else {
+		_lmessage = "*Related outputvalue pushed to output: "
+				+ std::to_string(_outputvalue);
+		LOG(LOG_INFO, _lmessage);
+	}
 
-				// debug
-				// std::cout << "numthresholded: " << _numthresholded << std::endl;
+	// 				output value here				//
 
-				// if number of subsequent points is enough, raise alarm
-				if (--_numthresholded == 0) {
-					//	number of subsequent differences found
+	// follow mode: latency of alarm/match decision since its data were read
+	if (_follow_input && (_isalarm || _ismatch)) {
+		_latency = af_now_usec() - _infollow.readtime;
+		_latency_sum += _latency;
+		_latency_count++;
+		if (_latency > _latency_max)
+			_latency_max = _latency;
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"*Decision latency (usec): " + std::to_string(_latency));
+	}
 
-					// alarm raised
-					_isalarm = 1;
-					_alarmraisetime = _curtime;
-					_iswait = 1;
-					_numthresholded = _number_of_points_to_alarm;
+	// reset pattern match incl. output
+	_ismatch = 0;
+	_matchdistance_out = -1;
+	_contivalue = 0;
 
-					// pattern starts
-					_patternid++;
-					_ispattern = 1;
-					_patterncount = _fingerprint_n;
+	return 0;
+}
 
-					// push current value as the first for analysis
-					if (_use_diff_value)
-						_seqdata.push_back(_diffnoabs);
-					else
-						_seqdata.push_back(_curval);
+// streaming transform of pattern of current column (a free one of the column),
+// fed by the last len values (pattern start: _pre_trigger values before the current
+// one and the current one), returns its index (-1 if not streaming)
+int _start_transform(int len) {
 
-				}
-			}
-		}
+	int s;
 
-		// amend diffavg, use _n_amend_avgdiff
+	if (!_stream_transform)
+		return -1;
 
-		// do not amend if in wait state of detection sequence based on _number_of_points_to_alarm
-		if (_iswait == 0 && _numthresholded == _number_of_points_to_alarm)
-			_diffavg = (_diffavg * (_n_amend_avgdiff - 1) + _diff)
-					/ _n_amend_avgdiff;
+	for (s = _column * _max_windows; _dwt[s].used; s++)
+		;
+	if (_dwt[s].n == 0)
+		af_dwt_init(_dwt[s], _wavelet_function, _fingerprint_n);
+	af_dwt_reset(_dwt[s]);
+	_dwt[s].used = true;
+
+	if (_early)
+		af_match_reset(_partial[s], _early_bank,
+				_matches_evaluation_logic == 1 ?
+						_fingerprint_match_negatives_from :
+						_fingerprint_match_positives_from,
+				_matches_evaluation_logic == 1 ?
+						_fingerprint_match_negatives_to :
+						_fingerprint_match_positives_to);
+
+	af_ring_column(_ring, _column, len, 0, _use_diff_value, &_seqdata[0]);
+	for (int i = 0; i < len; i++)
+		af_dwt_push(_dwt[s], _seqdata[i]);
+
+	return s;
+}
 
-		// if < 1, set 1
-		// if (_diffavg < 1)
-		//	_diffavg = 1;
+// fingerprint items computed since the last call added to partial distances,
+// pattern decided if lower bounds of distances to all bank patterns of matching
+// logic exceed the threshold (logic 1: match raised, logic 2: no match)
+void _decide_early(af_window &w) {
+
+	af_dwt &d = _dwt[w.dwt];
+	af_match_partial &m = _partial[w.dwt];
+	double threshold = _matches_evaluation_logic == 1 ?
+			_matching_distance_negatives_max : _matching_distance_positives_max;
+	double lower, lowermin = 1;
+
+	// no new items, bounds unchanged
+	if (m.consumed == d.nready && m.consumed > 0)
+		return;
+	for (; m.consumed < d.nready; m.consumed++)
+		af_match_add(m, _early_bank, d.order[m.consumed],
+				d.out[d.order[m.consumed]]);
+
+	for (unsigned int b = 0; b < _early_bank.size(); b++) {
+		lower = af_match_lower(m, b);
+		if (!(lower > threshold))
+			return;
+		if (lower < lowermin)
+			lowermin = lower;
+	}
 
-		// remember current value,
-		_lastval = _curval;
+	if (_matches_evaluation_logic == 2) {
+		w.early = -1;
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"*Pattern no " + std::to_string(w.patternid)
+							+ _column_text() + " decided early at " + _p1
+							+ " (" + std::to_string(d.cnt[0]) + " of "
+							+ std::to_string(_fingerprint_n)
+							+ " values): no positive bank pattern can match, distance >= "
+							+ std::to_string(lowermin));
+		return;
+	}
 
-		// output special debug line if alarm detected
-		if (_debug_level && _isalarm) {
-			_lmessage = "*Alarm detected at " + _p1
-					+ ", collecting measurements pattern "
-					+ std::to_string(_patternid);
-			LOG(LOG_INFO, _lmessage);
-		}
+	// logic 1, final match raised
+	w.early = 1;
+	_ismatch = 1;
+	_contivalue = lowermin;
+	_matchdistance_out = lowermin;
+	if (_debug_level) {
+		/*****************************************************************/
+		LOG(LOG_INFO, std::string(117, '*'));
+		LOG(LOG_INFO,
+				"***Final match raised for measurements pattern no "
+						+ std::to_string(w.patternid) + _column_text() + " at "
+						+ _p1 + "\n***"
+						+ "Logic 1 (final match raised early after "
+						+ std::to_string(d.cnt[0]) + " of "
+						+ std::to_string(_fingerprint_n)
+						+ " values because no negative bank pattern can match, distance >= "
+						+ std::to_string(lowermin) + ")");
+		LOG(LOG_INFO, std::string(117, '*'));
+		/*****************************************************************/
+	}
+}
 
-		// outputvalue is either _contivalue or _matchdistance_output
-
-		_outputvalue = _contivalue;
-		if (_matchdistance_to_output)
-			_outputvalue = _matchdistance_out;
-
-		// output debug line
-		if (_debug_level > 1) {
-			_lmessage = std::to_string(_lineid) + ";" + _p1 + ";"
-					+ std::to_string(_curval) + ";" + std::to_string(_diffnoabs)
-					+ ";" + std::to_string(_diffavg) + ";"
-					+ (_numthresholded == _number_of_points_to_alarm ? "0" : "1")
-					+ ";" + std::to_string(_isalarm) + ";"
-					+ std::to_string(_iswait) + ";"
-					+ std::to_string(_ispattern ? _patternid : 0) + ";"
-					+ std::to_string(_ismatch) + ";"
-					+ std::to_string(_matchdistance_out) + ";"
-					+ std::to_string(_contivalue) + ";"
-					+ std::to_string(_outputvalue);
+// releases transform of window w and removes it
+void _end_window(int w) {
+	if (_windows[w].dwt >= 0)
+		_dwt[_windows[w].dwt].used = false;
+	for (int k = w + 1; k < _ispattern; k++)
+		_windows[k - 1] = _windows[k];
+	_ispattern--;
+}
 
-			LOG(LOG_INFO, _lmessage);
+// evaluates pattern of window w completed by current measurement: fingerprint,
+// matching with patterns loaded from bank, fingerprint generation
+// returns non zero on fatal error
+int _evaluate_pattern(const af_window &w) {
+
+	int patternid = w.patternid;
+
+	if (w.dwt >= 0)
+		// transformed while collected
+		_vw = &_dwt[w.dwt].out[0];
+	else {
+		// pattern end, the last _fingerprint_n values before the current one
+		// (single column measurements used directly from the ring)
+		if (_columns == 1 && !_use_diff_value)
+			_dw = af_ring_window(_ring, _fingerprint_n, 1);
+		else {
+			af_ring_column(_ring, _column, _fingerprint_n, 1,
+					_use_diff_value, &_seqdata[0]);
+			_dw = &_seqdata[0];
 		}
 
-		//////////////////////////////////////////////////////////////////////////////////
-		// put _outputvalue to output
-		if (_debug_level && _matchdistance_out != -1) {
+		//debug
+		//std::cout << "Input data for wavelet:\n";
+		//for (int i = 0; i < _fingerprint_n; i++ )
+		//	std::cout << _dw[i] << std::endl;
 
-			//debug
-			//std::cout << "(debug) _contivalue: " << _contivalue << std::endl;
-			//std::cout << "(debug) _matchdistance__out: " << _matchdistance_out << std::endl;
+		// find fingerprint (uses pointer to wavelet function)
+		(*_wav_func)(_fingerprint_n, _dw, &_vwbuf[0], &_wavscratch[0]);
+		_vw = &_vwbuf[0];
+	}
+
+	// write fingerprint to log
+	if (_debug_level > 1) {
+		LOG(LOG_INFO,
+				"*Measurements for actual pattern collected, calculated fingerprint:");
+		_lmessage = "*";
+		for (int j = 0; j < _fingerprint_n; j++)
+			_lmessage = _lmessage + std::to_string(_vw[j]) + " ";
+		LOG(LOG_INFO, _lmessage);
+	}
+
+	// matching with bank patterns (unless decided while collected)
+	if (!w.early && _match_pattern(patternid))
+		return 1;
+
+	// debug
+	// std::cout << "(debug) _generate_fingerprints: " << _generate_fingerprints << std::endl;
+	// std::cout << "(debug) _matchpos_count: " << _matchpos_count << std::endl;
+	// std::cout << "(debug) _matchneg_count: " << _matchneg_count << std::endl;
+
+	// output to file, if not forbidden by generate_fingerprint logic
+	// debug
+	// std::cout << "(debug) _curtime: " << _curtime << std::endl;
+	// std::cout << "(debug) _genpattern_time: " << _genpattern_time << std::endl;
+	// std::cout << "(debug) genpattern_count: " << genpattern_count << std::endl;
+	// std::cout << "(debug) _matchpos_count: " << _matchpos_count << std::endl;
+	// std::cout << "(debug) _matchneg_count: " << _matchneg_count << std::endl;
+
+	if (_generate_fingerprints == 1
+			|| (_generate_fingerprints == 2 && !(_ismatch || w.early == 1))) {
+
+		//verify generating fingerprints throttle and shift time, if time limit passed
+		if ((_curtime / 1000000 - _genpattern_time / 1000000) > 60 * 60) {
+			_genpattern_time = _curtime;
+			_genpattern_count = 0;
+		}
+
+		if (_genpattern_hour_limit == 0
+				|| (_genpattern_count < _genpattern_hour_limit))
+
+				{
+
+			//increment counter of generated fingerprints
+			_genpattern_count++;
+
+			// find leading zeros
+			_patzeros = 0;
+			if (patternid < 10)
+				_patzeros = 3;
+			else if (patternid < 100)
+				_patzeros = 2;
+			else if (patternid < 10)
+				_patzeros = 1;
+
+			std::ofstream outputfile;
+
+			// debug
+			//std::cout << "(debug) patternid: " << patternid << std::endl;
+			//std::cout << "(debug) _p1: " << _p1 << std::endl;
+			//std::cout << "(debug) _wavelet_function: " << _wavelet_function << std::endl;
+
+			// build pattern filename (incl. directory)
+			_filenam = "w_" + std::string(_patzeros, '0')
+					+ std::to_string(patternid) + "_" + _p1;
+			if (_columns > 1)
+				_filenam += "_c" + std::to_string(_column + 1);
+
+			//amend filename (mainly for windows) - substitute certain characters by '_' or similar
+			while (_filenam.find(":") != std::string::npos)
+				_filenam = _filenam.replace(_filenam.find(":"), 1,
+						"_");
+			while (_filenam.find("-") != std::string::npos)
+				_filenam = _filenam.replace(_filenam.find("-"), 1,
+						"_");
+			while (_filenam.find(".") != std::string::npos)
+				_filenam = _filenam.replace(_filenam.find("."), 1,
+						"_");
+			while (_filenam.find(" ") != std::string::npos)
+				_filenam = _filenam.replace(_filenam.find(" "), 1,
+						"_");
+
+			// add directory and suffix for fingerprints filename
+			_filenam = _filenam +
+			// add suffix .fpr and fingerprint parameter id
+					".fpr" + std::to_string(_wavelet_function) +
+					// add fingerprint length
+					"_len" + std::to_string(_fingerprint_n);
+			// debug
+			//std::cout << "(debug) filename of wavelets: " << _filenam << std::endl;
+
+			outputfile.open(_fingerprints_directory + _filenam);
+			for (int i = 0; i < _fingerprint_n; i++) {
+				outputfile << std::fixed << _vw[i] << std::endl;
+			}
+			outputfile.close();
+
+			if (_debug_level) {
+				_lmessage = "*Fingerprint saved to file: " + _filenam;
+				LOG(LOG_INFO, _lmessage);
+			}
+
+		}
+
+		else {
+			//genpattern limit reached
+
+			if (_debug_level) {
+				_lmessage =
+						"*Fingerprint generation limit within hour reached, fingerprint not saved";
+				LOG(LOG_INFO, _lmessage);
+			}
+		}
+
+	}
+
+	// match raised here //////////////////////////////////////////////
+	if (_ismatch && _debug_level) {
+		/*****************************************************************/
+		LOG(LOG_INFO, std::string(117, '*'));
+		LOG(LOG_INFO, _match_comment);
+		LOG(LOG_INFO, std::string(117, '*'));
+		/*****************************************************************/
+	}
+
+	return 0;
+}
+
+// matches fingerprint _vw of pattern patternid with patterns loaded from bank,
+// final evaluation by matches_evaluation_logic, returns non zero on fatal error
+int _match_pattern(int patternid) {
+
+	// if patterns for comparison exist, do matching between
+	// current pattern i _vw and all patterns where:
+	// _numberfps - number of loaded patterns
+	// _fngpts - vector of vectors of loaded patterns
+	// _fngptsnames - vector of loaded patterns names
+	//              (_n.... for negatives or _p.... for positives)
+	// matches_evaluation_logic drives how patterns are matched
 
-			_lmessage = "*Related outputvalue pushed to output: "
-					+ std::to_string(_outputvalue);
+	if (_debug_level) {
+
+		// only if some patterns loaded
+		if (_numberfps) {
+			_lmessage =
+					"*Matching collected measurements pattern with patterns loaded"
+							" from bank (matching logic="
+							+ std::to_string(
+									_matches_evaluation_logic)
+							+ "):";
 			LOG(LOG_INFO, _lmessage);
 		}
 
-		// 				output value here				//
+	}
 
-		// reset pattern match incl. output
-		_ismatch = 0;
-		_matchdistance_out = -1;
-		_contivalue = 0;
+	_pos_count = 0;
+	_matchpos_count = 0;
+	_neg_count = 0;
+	_matchneg_count = 0;
+	_matchdistance_pos_min = 1; // initial max value
+	_matchdistance_neg_min = 1; // initial max value
 
-	} // of input values cycle while
+	// evaluate positives if necessary
+	if (_matches_evaluation_logic == 2
+			|| _matches_evaluation_logic == 3
+			|| _matches_evaluation_logic == 4) {
+
+		// try to match EACH negative match
+		for (int i = 0; i < _numberfps; i++) {
+			if (_fngptsnames[i].substr(0, 1) == "p") {
+
+				_pos_count++;
+
+				// calculate distance using parameters
+				_matchdistance = _eucl_dist(_vw, &_fngpts[i][0],
+						_fingerprint_match_positives_from,
+						_fingerprint_match_positives_to,
+						_fingerprint_length,
+						_distance_calculation_type);
+
+				// amend min found positive distances
+				if (_matchdistance < _matchdistance_pos_min)
+					_matchdistance_pos_min = _matchdistance;
+
+				if (_debug_level) {
+					_lmessage =
+							"*Actual pattern no "
+									+ std::to_string(patternid)
+									+ " and positive bank pattern '"
+									+ _fngptsnames[i]
+									+ "', matching items "
+									+ std::to_string(
+											_fingerprint_match_positives_from)
+									+ ".."
+									+ std::to_string(
+											_fingerprint_match_positives_to)
+									+ ", threshold="
+									+ std::to_string(
+											_matching_distance_positives_max)
+									+ ", match distance is "
+									+ std::to_string(_matchdistance)
+									+ "  "
+									+ ((_matchdistance
+											<= _matching_distance_positives_max) ?
+											"* individual match *" :
+											"* no individual match *");
+					LOG(LOG_INFO, _lmessage);
+				}
+
+				// match (first positive match is enough)
+				if (_matchdistance
+						<= _matching_distance_positives_max) {
+
+					_matchpos_count++;
+					_matchtestposname = _fngptsnames[i];
+
+				}
+			}
+
+			// break for loop if any positive when evaluation logic 2
+			// continuing in evaluation when evaluation logic 3 or 4
+			if (_matchpos_count
+					&& (_matches_evaluation_logic == 2
+							|| _matches_evaluation_logic == 3))
+				break;
+		}
+
+	}
+
+	// evaluate negatives (if necessary)
+	if (_matches_evaluation_logic == 1
+			|| _matches_evaluation_logic == 3) {
+
+		// try to match EACH negative match
+		for (int i = 0; i < _numberfps; i++) {
+			if (_fngptsnames[i].substr(0, 1) == "n") {
+
+				_neg_count++;
+
+				// calculate distance using parameters
+				_matchdistance = _eucl_dist(_vw, &_fngpts[i][0],
+						_fingerprint_match_negatives_from,
+						_fingerprint_match_negatives_to,
+						_fingerprint_length,
+						_distance_calculation_type);
+
+				if (_matchdistance < _matchdistance_neg_min)
+					_matchdistance_neg_min = _matchdistance;
+
+				// debug
+				//std::cout << "(debug) matchdistance: " << _matchdistance << std::endl;
+
+				if (_matchdistance
+						<= _matching_distance_negatives_max) {
+
+					_matchneg_count++;
+				}
+
+				if (_debug_level) {
+
+					_lmessage =
+							"*Actual pattern no "
+									+ std::to_string(patternid)
+									+ " and negative bank pattern '"
+									+ _fngptsnames[i]
+									+ "', matching items "
+									+ std::to_string(
+											_fingerprint_match_negatives_from)
+									+ ".."
+									+ std::to_string(
+											_fingerprint_match_negatives_to)
+									+ ", threshold="
+									+ std::to_string(
+											_matching_distance_negatives_max)
+									+ ", match distance is "
+									+ std::to_string(_matchdistance)
+									+ "  "
+									+ ((_matchdistance
+											<= _matching_distance_negatives_max) ?
+											"* individual match *" :
+											"* no individual match *");
+					LOG(LOG_INFO, _lmessage);
+				}
+
+			}
+		}
+
+	}
+
+	// final evaluation using evaluation logic
+
+	// prepare match comment
+	_match_comment =
+			"***Final match raised for measurements pattern no "
+					+ std::to_string(patternid) + _column_text() + " at "
+					+ _p1 + "\n***";
+
+	// default is nonmatch
+	_ismatch = 0;
+	_matchdistance_out = -1;  // default is "no match"
+	_contivalue = 0; // default is "no suspection"
+
+	switch (_matches_evaluation_logic) {
+
+	// If _matches_evaluation_logic = 0, no fingerprints matching is provided at all
+	case 0:
+		_ismatch = 1; // pure "alarm_noisereject + pattern related delay" like
+		_contivalue = 1;
+		_match_comment =
+				_match_comment
+						+ "Logic 0 (pure alarm_noisereject-like without bank patterns matching)";
+		break;
+
+		// If _matches_evaluation_logic = 1, not matching any negative pattern causes to raise match
+	case 1:
+		// _contivalue set even when not match
+		_contivalue = _matchdistance_neg_min;
+
+		// match logic
+		if (_matchneg_count == 0) {
+			_ismatch = 1;  // no negative pattern matched
+			_matchdistance_out = _matchdistance_neg_min;
+			_match_comment =
+					_match_comment
+							+ "Logic 1 (final match raised because no individual match for negative bank patterns raised)";
+		}
+		break;
+
+		// If _matches_evaluation_logic = 2, matching any positive pattern causes raise match
+	case 2:
+		// _contivalue set even when not match
+		_contivalue = 1 - _matchdistance_pos_min;
+
+		// match logic
+		if (_matchpos_count) {
+			_ismatch = 1;  // some new pattern
+			_matchdistance_out = _matchdistance_pos_min;
+			_match_comment =
+					_match_comment
+							+ "Logic 2 (final match raised because bank pattern '"
+							+ _matchtestposname
+							+ "' raised an individual match)";
+		}
+		break;
+
+		// If _matches_evaluation_logic = 3, not matching any negative patterns and matching any positive
+	case 3:
+
+		// _contivalue set even when not match
+		_contivalue = _matchdistance_neg_min;
+		if (_matchdistance_pos_min < _matchdistance_neg_min)
+			_contivalue = _matchdistance_pos_min;
+		_contivalue = 1 - _contivalue;
+
+		// match logic
+		if (_matchneg_count == 0 && _matchpos_count > 0) {
+			_ismatch = 1;  // some new pattern
+
+			// minimum distance from positives or negatives
+			_matchdistance_out = _matchdistance_neg_min;
+			if (_matchdistance_pos_min < _matchdistance_out)
+				_matchdistance_out = _matchdistance_pos_min;
+
+			_match_comment =
+					_match_comment
+							+ "Logic 3 (final match raised because no negative bank pattern individual match raised and positive bank pattern '"
+							+ _matchtestposname
+							+ "' raised an individual match)";
+		}
+		break;
+
+		// If _matches_evaluation_logic = 4, matching all positive patterns
+	case 4:
+		// _contivalue set even when not match
+		_contivalue = 1 - _matchdistance_pos_min;
+
+		// match logic
+		if (_matchpos_count) {
+			_ismatch = 1;  // some new pattern
+			_matchdistance_out = _matchdistance_pos_min;
+			_match_comment =
+					_match_comment
+							+ "Logic 4 (final match raised because "
+							+ std::to_string(_matchpos_count)
+							+ " positive bank pattern(s) raised individual match)";
+		}
+		break;
+
+	default: {
+		DLOG(LOG_ERROR,
+				"\nError\nUnknown evaluation logic "
+						+ std::to_string(_matches_evaluation_logic)
+						+ "\nExiting");
+#ifdef ALARM_FINGERPRINTS_STANDALONE_VERSION
+		return 1;
+#else
+		{
+			//helper code for ProcessGuard:   v[0] = -2.0; pushResult(v);
+
+		}
+#endif
+	}
+
+	} // of matches evaluation logic switch
 
 	return 0;
 }
 
-/*****************************************************************************
- * functions definitions
- *****************************************************************************/
+// reads next measurement record to _curtime and _curval (_ts for text input)
+// text lines are sampled, skipped and parsed in place, binary records only sampled
+// returns false at the end of input
+bool _next_record() {
 
-// trim string
-std::string trim(const std::string& str) {
-	size_t first = str.find_first_not_of(' ');
-	if (std::string::npos == first) {
-		return str;
+	if (_binary_input) {
+		while (af_bin_next(_inbin, _curtime,
+				_columns == 1 ? &_curval : &_curvals[0])) {
+
+			// sampling?
+			if (_cursample-- > 1)
+				continue;
+			else
+				_cursample = _sample_each;
+
+			return true;
+		}
+		return false;
 	}
-	size_t last = str.find_last_not_of(' ');
-	return str.substr(first, (last - first + 1));
+
+	while (af_text_next_line(_intext, _line, _semi)) {
+
+		_linecount++;
+
+		// debug output: copy of input line
+		// std::cout << std::endl << std::string(_line.b, _line.n) << std::endl;
+
+		// sampling?
+		if (_cursample-- > 1) {
+
+			// debug
+			// std::cout << "previous line sampled out" << std::endl;
+			continue;
+		} else
+			_cursample = _sample_each;
+
+		// patch: tries to skip "standard" heading lines containing certain character
+		// (only at the top of input, until the first measurement line)
+		if (_in_header && af_span_contains(_line, _skip_if_contains)) {
+			// debug
+			// std::cout << "(debug) skipped line" << std::endl;
+			continue;
+		}
+
+		// parses input line in place (no copies of line parts),
+		// ';' position is known from structural index of input
+
+		// skips if not found ';'
+		if (_semi == NULL)
+			continue;
+		pos = _semi - _line.b;
+
+		_ts.b = _line.b;  // first before ;, i.e. timestamp
+		_ts.n = pos;
+		_ts = af_trim(_ts);
+		_vs.b = _semi + 1;	// measured value
+		_vs.n = _line.n - pos - 1;
+		while (_vs.n > 0 && isspace(_vs.b[0])) {
+			_vs.b++;
+			_vs.n--;
+		}
+
+		// skips if no value
+		if (_vs.n == 0) {
+			_malformed_lines++;
+			continue;
+		}
+
+		// parse timestamp to microseconds, skip line if not a timestamp
+		// e.g. 10-03-2016 15:19:20.729915
+		if (!af_parse_timestamp(_ts, _tcache, _curtime)) {
+			_malformed_lines++;
+			continue;
+		}
+
+		// take current value to _curval, skip line if not a number
+		if (_columns == 1) {
+			if (!af_parse_double(_vs, _curval)) {
+				_malformed_lines++;
+				continue;
+			}
+		} else if (!_parse_values()) {
+			_malformed_lines++;
+			continue;
+		}
+
+		// header lines end with the first measurement line
+		_in_header = 0;
+
+		return true;
+	}
+
+	return false;
+}
+
+// parses _columns ';' separated values of _vs to _curvals
+// returns false if any of them is missing or not a number
+bool _parse_values() {
+
+	af_span v = _vs;
+	const char *q;
+
+	for (int i = 0; i < _columns; i++) {
+		if (!af_parse_double(v, _curvals[i]))
+			return false;
+		if (i == _columns - 1)
+			break;
+
+		// next value after ';'
+		q = (const char *) memchr(v.b, ';', v.n);
+		if (q == NULL)
+			return false;
+		v.n -= q + 1 - v.b;
+		v.b = q + 1;
+		while (v.n > 0 && isspace(v.b[0])) {
+			v.b++;
+			v.n--;
+		}
+	}
+
+	return true;
+}
+
+// moves column state to working variables
+void _channel_load(int c) {
+	_diffavg = _engine.diffavg[c];
+	_lastval = _engine.lastval[c];
+	_isalarm = _engine.isalarm[c];
+	_iswait = _engine.iswait[c];
+	_numthresholded = _engine.numthresholded[c];
+	_alarmraisetime = _engine.alarmraisetime[c];
+	_genpattern_time = _engine.genpattern_time[c];
+	_genpattern_count = _engine.genpattern_count[c];
+	_patternid = _engine.patternid[c];
+	_ispattern = _engine.ispattern[c];
+	for (int i = 0; i < _ispattern; i++)
+		_windows[i] = _engine.windows[c * _engine.nwin + i];
+}
+
+// moves working variables back to column state
+// column stays busy (scalar processing) until its first value is processed
+// and while it is in alarm detection, wait or pattern state
+void _channel_store(int c) {
+	_engine.diffavg[c] = _diffavg;
+	_engine.lastval[c] = _lastval;
+	_engine.isalarm[c] = _isalarm;
+	_engine.iswait[c] = _iswait;
+	_engine.numthresholded[c] = _numthresholded;
+	_engine.alarmraisetime[c] = _alarmraisetime;
+	_engine.genpattern_time[c] = _genpattern_time;
+	_engine.genpattern_count[c] = _genpattern_count;
+	_engine.patternid[c] = _patternid;
+	_engine.ispattern[c] = _ispattern;
+	for (int i = 0; i < _ispattern; i++)
+		_engine.windows[c * _engine.nwin + i] = _windows[i];
+	_engine.busy[c] = _lineid == 0 || _isalarm || _iswait || _ispattern
+			|| _numthresholded != _number_of_points_to_alarm;
+}
+
+// processes current measurement of column c by scalar code, returns non zero on fatal error
+int _process_column(int c) {
+	int err;
+
+	_column = c;
+	_channel_load(c);
+	_curval = _curvals[c];
+	err = _process_sample();
+	_channel_store(c);
+	return err;
+}
+
+// opens asynchronous reader of text input file or of stdin redirected from file
+// returns its file descriptor, -1 if not possible (binary file, pipe, ...)
+int _open_async_input() {
+
+	int fd = 0;
+	off_t start = 0;
+	char magic[4];
+
+	if (!_input_file.empty()) {
+		fd = open(_input_file.c_str(), O_RDONLY);
+		if (fd < 0)
+			return -1;
+	} else
+		start = lseek(fd, 0, SEEK_CUR);
+
+	// binary format or compressed input is read other way
+	if (start >= 0 && pread(fd, magic, sizeof(magic), start) == sizeof(magic)
+			&& (memcmp(magic, AF_BIN_MAGIC, sizeof(magic)) == 0
+					|| af_decomp_format(magic, sizeof(magic))
+							!= AF_DECOMP_NONE)) {
+		if (fd)
+			close(fd);
+		return -1;
+	}
+
+	if (start < 0 || af_uring_open(_inuring, fd, start, _async_reads)) {
+		if (fd)
+			close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+// opens reader of standard input, compressed input recognized from its first bytes
+// returns 0 if ok
+int _open_stdin() {
+
+	int fd = 0;
+	static char magic[4];	// used by decompression thread later
+	long n = 0;
+	long got;
+
+	while (n < (long) sizeof(magic)
+			&& (got = af_fd_read(&fd, magic + n, sizeof(magic) - n)) > 0)
+		n += got;
+
+	if (af_decomp_format(magic, n) != AF_DECOMP_NONE)
+		return _open_compressed(magic, n, 0);
+
+	af_text_open_fd(_intext, 0);
+	af_text_preload(_intext, magic, n);
+
+	return 0;
+}
+
+// opens text reader of compressed data (first n bytes in memory, the rest from fd)
+// returns 0 if ok
+int _open_compressed(const char *mem, size_t n, int fd) {
+
+	_compressed_input = af_decomp_format(mem, n);
+
+	if (af_decomp_open(_indecomp, _compressed_input, mem, n, fd)) {
+		DLOG(LOG_ERROR,
+				"Cannot decompress " + std::string(af_decomp_name(_compressed_input))
+						+ " input (format may not be supported by this build)\nExiting");
+		_compressed_input = AF_DECOMP_NONE;
+		return 1;
+	}
+
+	af_text_open_source(_intext, &af_decomp_read, &_indecomp);
+
+	if (_debug_level)
+		LOG(LOG_INFO,
+				"\n*Input compressed by "
+						+ std::string(af_decomp_name(_compressed_input))
+						+ ", decompressed on separate thread");
+
+	return 0;
+}
+
+// offset in text input file to start reading at, using index of the file
+// (0 if no --from or no valid index)
+size_t _seek_input() {
+
+	std::vector<af_index_entry> idx;
+	size_t offset;
+
+	if (_from.empty())
+		return 0;
+
+	if (af_index_load(_input_file, idx)) {
+		if (_debug_level)
+			LOG(LOG_INFO,
+					"\n*No valid index '" + af_index_name(_input_file)
+							+ "', input read from its start (may use --build-index)");
+		return 0;
+	}
+
+	offset = af_index_seek(idx, _start_time);
+	if (offset > _inmap.size)
+		offset = 0;
+
+	if (_debug_level)
+		LOG(LOG_INFO,
+				"\n*Input read from offset " + std::to_string(offset)
+						+ " (index '" + af_index_name(_input_file) + "')");
+
+	return offset;
+}
+
+// block mode: records are read to block, leading records proven quiet
+// (no threshold crossing possible, not in alarm/wait/pattern state)
+// only amend diffavg and lastval, the rest is processed one by one
+// until quiet state is reached again
+// with -Q, quiet runs of records are skipped by their summary (aggregated diffavg
+// update), record by record proof is used for the rest
+int _run_blocks() {
+
+	bool copyts = !_binary_input && _intext.read != NULL;
+	bool quiet;
+	int q = _quiet_skip < _block_size ? _quiet_skip : _block_size;
+
+	_blockts.resize(_block_size);
+	_blockval.resize(_block_size);
+	_blockspan.resize(_block_size);
+	if (copyts)
+		_blocktext.resize((size_t) _block_size * AF_BLOCK_TS_LEN);
+	_blockdecay.resize(_block_size);
+	_blockquiet = 0;
+	_blockskipped = 0;
+	af_block_decay(&_blockdecay[0], _block_size, _n_amend_avgdiff);
+	if (q) {
+		_blockweights.resize(q + 1);
+		af_block_weights(&_blockweights[0], q, _n_amend_avgdiff);
+	}
+
+	for (;;) {
+
+		// read block (binary input without sampling copied block by block)
+		if (_binary_input && _sample_each == 1)
+			_blockn = af_bin_read(_inbin, &_blockts[0], &_blockval[0],
+					_block_size);
+		else
+			for (_blockn = 0; _blockn < _block_size && _next_record();
+					_blockn++) {
+				_blockts[_blockn] = _curtime;
+				_blockval[_blockn] = _curval;
+				_blockspan[_blockn] = _ts;
+				if (copyts) {
+					_blockspan[_blockn].b = &_blocktext[(size_t) _blockn
+							* AF_BLOCK_TS_LEN];
+					if (_blockspan[_blockn].n > AF_BLOCK_TS_LEN)
+						_blockspan[_blockn].n = AF_BLOCK_TS_LEN;
+					memcpy((char *) _blockspan[_blockn].b, _ts.b,
+							_blockspan[_blockn].n);
+				}
+			}
+		if (_blockn == 0)
+			return 0;
+
+		_blocki = 0;
+		while (_blocki < _blockn) {
+
+			// quiet state: leading records proven not to cross the threshold
+			// (runs of q records by their summary with -Q)
+			quiet = _lineid > 0 && !_iswait && !_ispattern
+					&& _numthresholded == _number_of_points_to_alarm;
+			_blockq = 0;
+			while (quiet && q && _blocki + _blockq + q <= _blockn
+					&& af_block_skip(&_blockval[_blocki + _blockq], q,
+							_lastval, _diffavg, _multiplicator_to_detect,
+							&_blockdecay[0], &_blockweights[0]))
+				_blockq += q;
+			_blockskipped += _blockq;
+			if (quiet && _blockq == 0) {
+				// (with -Q up to the next run only)
+				_blockq = af_block_quiet(&_blockval[_blocki],
+						q && _blockn - _blocki > q ? q : _blockn - _blocki,
+						_lastval, _diffavg, _multiplicator_to_detect,
+						&_blockdecay[0]);
+				af_block_amend(&_blockval[_blocki], _blockq, _lastval,
+						_diffavg, _n_amend_avgdiff);
+			}
+
+			if (_blockq > 0) {
+				af_ring_push_rows(_ring, &_blockval[_blocki], _blockq);
+				_blocki += _blockq;
+				_lineid += _blockq;
+				_blockquiet += _blockq;
+				_curtime = _lasttime = _blockts[_blocki - 1];
+				continue;
+			}
+
+			// candidate record
+			_curtime = _blockts[_blocki];
+			_curval = _blockval[_blocki];
+			_ts = _blockspan[_blocki];
+			_lineid++;
+			af_ring_push(_ring, &_curval);
+			if (_process_sample())
+				return 1;
+			_blocki++;
+		}
+
+		if (!_checkpoint_file.empty() && _checkpoint(false))
+			return 1;
+	}
+}
+
+// writes checkpoint of detector state if due by input time (or always)
+// returns non zero on fatal error
+int _checkpoint(bool always) {
+
+	af_ckpt_header h;
+	af_ckpt c;
+
+	if (!always && _curtime < _checkpoint_next)
+		return 0;
+	_checkpoint_next = _curtime + (long long) _checkpoint_interval_sec * 1000000;
+
+	af_ckpt_header_init(h, _columns, _fingerprint_n, _max_windows, _detector,
+			_baseline, _wavelet_function);
+	if (af_ckpt_create(c, _checkpoint_file, h) == 0)
+		_checkpoint_state(c);
+	if (c.f == NULL || af_ckpt_commit(c)) {
+		DLOG(LOG_ERROR,
+				"Cannot write checkpoint file '" + _checkpoint_file
+						+ "' (may verify --checkpoint parameter)\nExiting");
+		return 1;
+	}
+
+	return 0;
+}
+
+// restores detector state from checkpoint file (--resume), starts cold if the file
+// does not exist or does not fit the parameters, returns non zero on fatal error
+int _restore() {
+
+	af_ckpt_header h, cur;
+	af_ckpt c;
+	int err;
+
+	if (_checkpoint_file.empty()) {
+		DLOG(LOG_ERROR, "\nresume (--resume) requires checkpoint file (--checkpoint)\nExiting");
+		return 1;
+	}
+
+	err = af_ckpt_open(c, _checkpoint_file, h);
+	af_ckpt_header_init(cur, _columns, _fingerprint_n, _max_windows, _detector,
+			_baseline, _wavelet_function);
+	if (err == 0 && memcmp(&h, &cur, sizeof(h)) != 0) {
+		af_ckpt_close(c);
+		err = 3;
+	}
+	if (err) {
+		if (_debug_level)
+			LOG(LOG_WARNING,
+					"\n*WARNING: checkpoint '" + _checkpoint_file + "' "
+							+ (err == 1 ? "not found" :
+								err == 2 ? "is not a checkpoint file" :
+									"written with other columns, fingerprint_length, "
+									"max_windows, detector, baseline or wavelet_function")
+							+ ", detector starts cold");
+		return 0;
+	}
+
+	_checkpoint_state(c);
+	if (af_ckpt_close(c)) {
+		DLOG(LOG_ERROR,
+				"Checkpoint file '" + _checkpoint_file
+						+ "' is corrupted\nExiting");
+		return 1;
+	}
+
+	if (_debug_level)
+		LOG(LOG_INFO,
+				"\n*Detector state restored from checkpoint '" + _checkpoint_file
+						+ "' (" + std::to_string(_lineid) + " records processed before)");
+
+	return 0;
+}
+
+// state written or read in the same order (c.save), the run continues after
+// reading exactly as it would after the last checkpointed record
+void _checkpoint_state(af_ckpt &c) {
+
+	uint64_t bank[2], cur[2];
+	int32_t ringv[2];
+
+	af_ckpt_io(c, &_lineid, sizeof(_lineid));
+	af_ckpt_io(c, &_lasttime, sizeof(_lasttime));
+	af_ckpt_io(c, &_lost_windows, sizeof(_lost_windows));
+
+	// generation of the bank the patterns in progress are matched with
+	cur[0] = bank[0] = _numberfps;
+	cur[1] = bank[1] = af_ckpt_hash(_fngptsnames, _numberfps);
+	af_ckpt_io(c, bank, sizeof(bank));
+	if (!c.save && c.ok && (bank[0] != cur[0] || bank[1] != cur[1])
+			&& _debug_level)
+		LOG(LOG_WARNING,
+				"\n*WARNING: patterns bank changed since checkpoint, patterns in progress "
+						"matched with the current bank");
+
+	// last input rows (patterns in progress, pre-trigger)
+	ringv[0] = _ring.pos;
+	ringv[1] = _ring.filled;
+	af_ckpt_io(c, ringv, sizeof(ringv));
+	af_ckpt_io_vec(c, _ring.data, _ring.data.size());
+	if (!c.save) {
+		if (!(ringv[0] >= 0 && ringv[0] < _ring.cap)
+				|| _ring.data.size() != (size_t) 2 * _ring.cap * _ring.n)
+			c.ok = false;
+		if (!c.ok)
+			return;
+		_ring.pos = ringv[0];
+		_ring.filled = ringv[1];
+	}
+
+	// state of each column (multi column: through the working variables)
+	for (_column = 0; _column < _columns && c.ok; _column++) {
+		if (_columns > 1 && c.save)
+			_channel_load(_column);
+		_checkpoint_column(c);
+		if (_columns > 1 && !c.save && c.ok)
+			_channel_store(_column);
+	}
+	_column = 0;
+}
+
+// state of current column in working variables
+void _checkpoint_column(af_ckpt &c) {
+
+	int32_t v[6];
+	double m[3];
+
+	af_ckpt_io(c, &_diffavg, sizeof(_diffavg));
+	af_ckpt_io(c, &_lastval, sizeof(_lastval));
+	af_ckpt_io(c, &_alarmraisetime, sizeof(_alarmraisetime));
+	af_ckpt_io(c, &_genpattern_time, sizeof(_genpattern_time));
+
+	v[0] = _isalarm;
+	v[1] = _iswait;
+	v[2] = _numthresholded;
+	v[3] = _genpattern_count;
+	v[4] = _patternid;
+	v[5] = _ispattern;
+	af_ckpt_io(c, v, sizeof(v));
+	if (!c.save) {
+		if (!c.ok || !(v[5] >= 0 && v[5] <= _max_windows)) {
+			c.ok = false;
+			return;
+		}
+		_isalarm = v[0];
+		_iswait = v[1];
+		_numthresholded = v[2];
+		_genpattern_count = v[3];
+		_patternid = v[4];
+		_ispattern = v[5];
+	}
+
+	// patterns in progress, streaming transforms fed again from the ring
+	for (int i = 0; i < _ispattern && c.ok; i++) {
+		v[0] = _windows[i].patternid;
+		v[1] = _windows[i].count;
+		v[2] = _windows[i].early;
+		af_ckpt_io(c, v, 3 * sizeof(int32_t));
+		if (c.save)
+			continue;
+		if (!(v[1] >= 1 && v[1] <= _fingerprint_n)) {
+			c.ok = false;
+			return;
+		}
+		_windows[i].patternid = v[0];
+		_windows[i].count = v[1];
+		_windows[i].early = v[2];
+		_windows[i].dwt = _start_transform(_fingerprint_n + 1 - v[1]);
+	}
+
+	// state of estimators of the column
+	if (_baseline == AF_BASELINE_MEDIAN) {
+		af_median &md = _median[_column];
+		m[0] = md.total;
+		m[1] = md.below;
+		m[2] = md.w;
+		v[0] = md.med;
+		af_ckpt_io_vec(c, md.cnt, md.cnt.size());
+		af_ckpt_io(c, m, sizeof(m));
+		af_ckpt_io(c, v, sizeof(int32_t));
+		if (!c.save) {
+			if (!c.ok || !(v[0] >= 0 && (size_t) v[0] < md.cnt.size())) {
+				c.ok = false;
+				return;
+			}
+			md.total = m[0];
+			md.below = m[1];
+			md.w = m[2];
+			md.med = v[0];
+		}
+	}
+	if (_detector) {
+		af_wdet &wd = _wdet[_column];
+		v[0] = wd.xpos;
+		v[1] = wd.apos;
+		v[2] = wd.filled;
+		af_ckpt_io_vec(c, wd.x, wd.x.size());
+		af_ckpt_io_vec(c, wd.a, wd.a.size());
+		af_ckpt_io(c, v, 3 * sizeof(int32_t));
+		if (!c.save) {
+			if (!c.ok || !(v[0] >= 0 && (size_t) v[0] < wd.x.size())
+					|| !(v[1] >= 0 && (size_t) v[1] < wd.a.size())) {
+				c.ok = false;
+				return;
+			}
+			wd.xpos = v[0];
+			wd.apos = v[1];
+			wd.filled = v[2];
+		}
+	}
+}
+
+// lifting (af_lift) compared with the convolution (af_daub_transform) for each
+// family on all fingerprint files of _fingerprints_directory (the longest power
+// of 2 part of each), returns 0 if all differences are below AF_LIFT_TOLERANCE
+int _check_lifting_bank() {
+
+	std::regex fpr(".*\\.fpr.*");
+	std::vector<double> v;
+	std::string linefile, fn;
+	af_span linespan;
+	double linevalue, d;
+	double worst[AF_DAUB_MAX / 2 + 1] = { 0 };
+	char num[32];
+	int files = 0, failed = 0, n, w;
+	DIR *dir;
+	struct dirent *ent;
+
+	if ((dir = opendir(&_fingerprints_directory[0])) == NULL) {
+		DLOG(LOG_ERROR,
+				"\nCannot open directory '" + _fingerprints_directory
+						+ "' for --check-lifting (may verify -p parameter)\nExiting");
+		return 1;
+	}
+	while ((ent = readdir(dir)) != NULL) {
+		fn = ent->d_name;
+		if (!std::regex_match(fn, fpr))
+			continue;
+		std::ifstream lfpfile(_fingerprints_directory + fn);
+		v.clear();
+		while (std::getline(lfpfile, linefile)) {
+			linespan.b = linefile.c_str();
+			linespan.n = linefile.size();
+			if (af_parse_double(linespan, linevalue))
+				v.push_back(linevalue);
+		}
+		for (n = 1; 2 * n <= (int) v.size(); n *= 2)
+			;
+		if (n < 4)
+			continue;
+		files++;
+		for (w = AF_DAUB_MIN; w <= AF_DAUB_MAX; w += 2) {
+			d = af_lift_check(w, n, &v[0]);
+			if (d > worst[w / 2])
+				worst[w / 2] = d;
+		}
+	}
+	closedir(dir);
+
+	if (files == 0) {
+		DLOG(LOG_ERROR,
+				"\nNo fingerprint files (.fpr, at least 4 values) in directory '"
+						+ _fingerprints_directory + "' for --check-lifting\nExiting");
+		return 1;
+	}
+
+	snprintf(num, sizeof(num), "%.3g", AF_LIFT_TOLERANCE);
+	LOG(LOG_INFO,
+			"\n*Lifting compared with convolution on " + std::to_string(files)
+					+ " fingerprint files (largest relative difference, tolerance "
+					+ num + "):");
+	for (w = AF_DAUB_MIN; w <= AF_DAUB_MAX; w += 2) {
+		if (worst[w / 2] > AF_LIFT_TOLERANCE)
+			failed++;
+		snprintf(num, sizeof(num), "%.3g", worst[w / 2]);
+		LOG(LOG_INFO,
+				"*daub" + std::to_string(w) + ": " + num
+						+ (worst[w / 2] > AF_LIFT_TOLERANCE ? "   FAILED" : ""));
+	}
+	if (failed) {
+		DLOG(LOG_ERROR,
+				"\nLifting differs from convolution for " + std::to_string(failed)
+						+ " wavelet families\nExiting");
+		return 1;
+	}
+	return 0;
+}
+
+// lead-in record warms up detector of each column
+void _warm_up() {
+	af_ring_push(_ring, _columns == 1 ? &_curval : &_curvals[0]);
+	if (_columns == 1)
+		_warm_sample();
+	else
+		for (_column = 0; _column < _columns; _column++) {
+			_channel_load(_column);
+			_curval = _curvals[_column];
+			_warm_sample();
+			_channel_store(_column);
+		}
+	_warmup_count++;
+}
+
+// noise level (diffavg) amended as out of alarm, no detection
+void _warm_sample() {
+	if (_warmup_count == 0)
+		_lastval = _curval;
+	_diff = _detector ?
+			af_wdet_next(_wdet[_column], _curval) : fabs(_curval - _lastval);
+	_amend_baseline();
+	_lastval = _curval;
+}
+
+// amends baseline (noise level) of current column by _diff
+void _amend_baseline() {
+	if (_baseline == AF_BASELINE_MEDIAN)
+		_diffavg = af_median_next(_median[_column], _diff);
+	else
+		_diffavg = (_diffavg * (_n_amend_avgdiff - 1) + _diff)
+				/ _n_amend_avgdiff;
+}
+
+// releases input readers
+void _close_input() {
+	if (_compressed_input) {
+		if (_indecomp.done.load() < 0)
+			DLOG(LOG_WARNING,
+					"*WARNING: compressed input is corrupted or truncated");
+		af_decomp_close(_indecomp);
+		_compressed_input = AF_DECOMP_NONE;
+	}
+	af_text_close(_intext);
+	af_mmap_close(_inmap);
+	if (_infd >= 0) {
+		af_uring_close(_inuring);
+		if (_infd)
+			close(_infd);
+		_infd = -1;
+	}
+}
+
+// ends following of input file (SIGINT, SIGTERM)
+void _follow_signal(int) {
+	af_follow_stop();
+}
+
+// column info for messages (empty for single column input)
+std::string _column_text() {
+	if (_columns == 1)
+		return "";
+	return " (column " + std::to_string(_column + 1) + ")";
 }
 
 // standalone only LOG and DLOG functions
@@ -9,6 +9,22 @@
 #define ALARM_FINGERPRINTS_HPP_
 
 #include "wavelet_ms.hpp"
+#include "af_input.hpp"
+#include "af_parse.hpp"
+#include "af_binary.hpp"
+#include "af_follow.hpp"
+#include "af_uring.hpp"
+#include "af_decomp.hpp"
+#include "af_index.hpp"
+#include "af_engine.hpp"
+#include "af_ring.hpp"
+#include "af_dwt.hpp"
+#include "af_match.hpp"
+#include "af_wdet.hpp"
+#include "af_baseline.hpp"
+#include "af_checkpoint.hpp"
+#include "af_daub.hpp"
+#include "af_lift.hpp"
 
 // standalone version helper //////////////////////////
 // comment the following line if not standalone version
@@ -66,8 +82,16 @@ int _fingerprint_match_negatives_to;
 
 // Default function for wavelet method (pointer to function)
 // Daubechie level of function, e.g. 12 = "daub12" wavelet
+// (fingerprint written to caller-owned buffer, no allocation per pattern)
 int _wavelet_function;
-double * (*_wav_func)(int, double *); // default pointer to function
+af_daub_func _wav_func; // default pointer to function
+
+// --lifting: patterns transformed by lifting steps of the wavelet (af_lift),
+// fingerprints equal to the convolution up to rounding; not used by -S 1
+int _lifting;
+// --check-lifting: lifting compared with the convolution for each family on
+// each fingerprint file of fingerprints_directory, then exit (0 if all agree)
+int _check_lifting;
 
 // If fingerprints should be generated to files
 // 0 used for matching run
@@ -124,6 +148,113 @@ int _matchdistance_to_output;
 // 0 means unlimited
 int _genpattern_hour_limit;
 
+// Input file read through memory mapping (lines parsed in place, without copying)
+// Empty means standard input
+// If file starts with binary format header (see af_binary.hpp), it is read as binary
+// Text input compressed by gzip (or zstd if built with AF_WITH_ZSTD) is recognized
+// and decompressed on a separate thread, also on standard input
+std::string _input_file;
+
+// If not empty, input is only converted to binary format file of this name
+// (binary file then can be used as _input_file for much faster processing)
+std::string _convert_file;
+
+// Number of value columns in input lines (timestamp;value1;value2;...)
+// Each column is evaluated independently with its own alarm detection
+// and pattern state, fingerprints are shared by all columns
+int _columns;
+
+// Follow mode for input file growing during the run (text format only)
+// 0 - input file read once up to its end
+// 1 - input file read from its start and then followed (as tail -F)
+// 2 - only data appended to input file after start are read
+// Following ends on SIGINT/SIGTERM
+int _follow_input;
+
+// Number of asynchronous reads in flight for text input file (or stdin redirected from file)
+// 0 - input file memory mapped, stdin read sequentially
+// >= 1 - io_uring reads (pread if io_uring not available) of AF_URING_BLOCK bytes,
+//        parsing of one buffer overlaps with reading of the next ones
+int _async_reads;
+
+// Block mode: if > 0, single column input is read in blocks of _block_size records,
+// runs of records proven not to come near the alarm threshold (vectorized bound
+// of diffavg decay) only amend diffavg, the other records are processed one by one
+// Output is the same as without block mode; used only without -T, --from, --to and
+// with debug_level < 2
+int _block_size;
+
+// Quiet period skip-scan in block mode (-Q): if > 0, blocks are summarized in runs of
+// _quiet_skip records (max |diff|, weighted sum of |diff|), runs with max |diff| proven
+// below the alarm threshold are skipped, diffavg amended by one aggregated update of
+// the run, equal to the record by record update up to rounding (alarms extremely
+// close to the threshold may differ from the run without -Q)
+// The run must be short relative to n_amend_avgdiff (e.g. n_amend_avgdiff / 8), the
+// proof assumes diffavg decaying over the whole run; binary input profits most,
+// text input is dominated by parsing
+int _quiet_skip;
+
+// Maximum number of patterns collected concurrently (-O)
+// 1 - alarm detection waits until the pattern is collected (alarms during it are not detected)
+// > 1 - detection continues after wait_state_usec, each alarm starts own pattern window
+//       over the same input rows (alarms with no free window counted as lost)
+#define AF_WINDOWS_MAX 64
+int _max_windows;
+
+// Wavelet transform of patterns (-S)
+// 0 - whole pattern transformed after its end (_wav_func)
+// 1 - streaming transform while pattern is collected (af_dwt, same fingerprint),
+//     only boundary coefficients computed after the last value
+int _stream_transform;
+
+// Early decision of pattern while collected (-E), only with -S 1, distance_calculation_type 1
+// and matches_evaluation_logic 1 or 2: as soon as lower bounds of distances of partially
+// transformed fingerprint show that no bank pattern (negatives for logic 1, positives
+// for logic 2) can match, final match is raised (logic 1) or pattern rejected (logic 2)
+// Matchdistance/contivalue of such patterns is the lower bound of distance
+int _early_decision;
+
+// Alarm detector (-D)
+// 0 - absolute difference of subsequent values against its average (diffavg)
+// 1 - magnitude of first and second level wavelet details (filters of wavelet_function)
+//     against its average; each column processed by scalar code, no block mode
+int _detector;
+
+// Baseline (noise level) estimator of the detector (-A), see af_baseline.hpp
+// 0 - average of |diff| amended by n_amend_avgdiff (diffavg)
+// 1 - streaming median of |diff| (quantile sketch, same time constant), robust
+//     against single spikes; each column processed by scalar code, no block mode
+int _baseline;
+
+// Time range to process (--from, --to), timestamps in the input format,
+// e.g. "10-03-2016 15:19:20" or "10-03-2016 15:19:20.729915", empty means unlimited
+// With index of input file (see --build-index), processing starts directly near the range
+std::string _from;
+std::string _to;
+
+// Lead-in before --from in seconds (--lead-in): records within it only warm up
+// the noise level of the detector (no alarms, no patterns)
+int _lead_in_sec;
+
+// If > 0, only timestamp index of input file (-F) with entries each _index_interval_sec
+// seconds is built to <input file>.afx (--build-index[=seconds], default 60)
+int _index_interval_sec;
+
+// Number of values before the alarm included in the pattern (--pre-trigger),
+// the pattern then covers the onset of the event (< fingerprint_length)
+int _pre_trigger;
+
+// Checkpoint of detector state (--checkpoint): if not empty, state (noise level,
+// alarm/wait counters, patterns in progress with the last input rows, pattern
+// ids, generation counters) is written to this file each _checkpoint_interval_sec
+// seconds of input time (--checkpoint-interval) and at the end of input
+// --resume: state restored from the file at start (if it exists and was written
+// with the same columns, fingerprint_length, max_windows, detector, baseline and
+// wavelet_function), so no warm-up is needed and patterns in progress continue
+std::string _checkpoint_file;
+int _checkpoint_interval_sec;
+int _resume;
+
 // Non-parameters definitions
 // Maximum number of fingerprints to load
 #define MAX_FINGEPRINTS_TO_LOAD 500
@@ -138,21 +269,74 @@ float _diffavg;
 
 int _fingerprint_n;
 // variables for patterns generating/matching
+// last input rows always kept in _ring, pattern is a window of it
+// (_seqdata: pattern copied from the ring for more columns or differences)
+af_ring _ring;
 std::vector<double> _seqdata;
+std::vector<af_dwt> _dwt;	// streaming transforms, max_windows for each column
+// early decision: in use, bank patterns compared, partial distances of transforms
+bool _early;
+std::vector<const double *> _early_bank;
+std::vector<af_match_partial> _partial;
+// wavelet energy detector of each column
+std::vector<af_wdet> _wdet;
+// median baseline estimator of each column (-A 1)
+std::vector<af_median> _median;
 double* _dw;
 double* _vw; 	// wavelets results
+std::vector<double> _vwbuf, _wavscratch;	// fingerprint and workspace of _wav_func
 int _patzeros;  // number of zeros before patternid
 int _cursample; // init sample count
 
 // variables for read data and parsing
-std::string _lineread, _p1, _p2;
+std::string _p1;
+af_mmap_file _inmap;	// memory mapped input file (-F)
+af_text_reader _intext;	// reader of text input (memory mapped file or stdin)
+af_span _line;	// current input line
+const char *_semi;	// first ';' of current line, NULL if none
+int _in_header;	// 1 until the first measurement line is read (header lines skipping)
+af_span _ts;	// timestamp part of current line
+af_span _vs;	// value part of current line
+long long _linecount;	// number of input text lines read
+int _binary_input;	// 1 if input file is in binary format
+af_bin_reader _inbin;	// reader of binary input file
+af_bin_writer _binout;	// writer of binary file (-C)
+af_follow _infollow;	// followed input file (-T)
+af_uring_reader _inuring;	// asynchronous reader of input file (-U)
+int _infd;	// input file descriptor for asynchronous reader, -1 if not used
+af_decomp _indecomp;	// decompressing reader of compressed input
+int _compressed_input;	// compression format of input (AF_DECOMP_...)
+
+// block mode: records of block, decay bounds of diffavg
+// (timestamps text copied only if input buffer may be reused while block is read)
+#define AF_BLOCK_TS_LEN 64
+std::vector<long long> _blockts;
+std::vector<double> _blockval;
+std::vector<af_span> _blockspan;
+std::vector<char> _blocktext;
+std::vector<double> _blockdecay;
+std::vector<double> _blockweights;	// weights of aggregated diffavg update (-Q)
+int _blockn;
+int _blocki;
+int _blockq;
+long long _blockquiet;	// number of records proven quiet
+long long _blockskipped;	// number of records in blocks skipped by summary (-Q)
+
+// input time of the next checkpoint (usec)
+long long _checkpoint_next;
+
+// time range to process (usec), start of lead-in, number of lead-in records
+long long _from_time, _to_time, _start_time;
+long long _warmup_count;
+
+// follow mode: delay between reading of data and alarm/match decision (usec)
+long long _latency, _latency_max, _latency_sum;
+long long _latency_count;
 
 // helper variable for string char conversion and other standalone only
 char* c;
-// helper tm structure for conversion
-struct tm t = { 0 };  // Initialize to 0
-// helper working variables for timestamp parsing
-int d, m, y, h, mi, s, ms;
+// cache of the timestamp day/hour base for parsing
+af_time_cache _tcache;
 // helper position variable
 unsigned long int pos;
 // helper for parsing
@@ -164,18 +348,21 @@ int _isalarm;
 int _iswait;
 int _numthresholded;
 
-// variables for alarm delay calculation
-struct timeval _lasttime; // large enough
-struct timeval _curtime;
-struct timeval _alarmraisetime;    // small enough
+// variables for alarm delay calculation (microseconds since epoch)
+long long _lasttime; // large enough
+long long _curtime;
+long long _alarmraisetime;    // small enough
 
 // generation patterns count related
-struct timeval _genpattern_time; // recorded time of generating fingerprint
+long long _genpattern_time; // recorded time of generating fingerprint
 int _genpattern_count;
 
 // line id
 long long _lineid;
 
+// number of skipped input lines with malformed timestamp or value
+long long _malformed_lines;
+
 // values for calculations (mind type)
 double _curval, _lastval; // current and last value
 double _diff; // difference from previous value, absolute value
@@ -183,8 +370,10 @@ double _diffnoabs; // noabsvalue
 
 // patterns related variables
 int _patternid;
-int _ispattern; 	// status variable for pattern tracking
-int _patterncount; 	// counts current pattern length
+int _ispattern; 	// number of patterns being collected
+std::vector<af_window> _windows;	// patterns being collected (in order of start)
+bool _windowlost;	// alarm of current measurement without free window
+long long _lost_windows;
 std::string _filenam;	// work wariable for pattern filename
 int _ismatch;		// variable indicating final match
 int _numberfps; // "real" counter of fingerprints
@@ -198,6 +387,13 @@ double _contivalue;
 double _outputvalue;
 std::string _match_comment;
 
+// multi column input: states of columns (see af_engine.hpp), current column and values
+// while a column is processed by scalar code, its state is loaded to the working variables
+af_engine _engine;
+int _nscalar;	// number of columns for scalar processing in current record
+int _column;
+std::vector<double> _curvals;
+
 //define vector for fingerprints
 std::vector<std::vector<double> > _fngpts;
 
@@ -229,6 +425,60 @@ std::regex _matchstr2;
 // trim function
 std::string trim(const std::string&);
 
+// reads next measurement record to _curtime and _curval (_curvals)
+bool _next_record();
+bool _parse_values();
+
+// processes current measurement in working variables
+int _process_sample();
+// starts streaming transform of new pattern, evaluates completed pattern
+int _start_transform(int);
+int _evaluate_pattern(const af_window &);
+int _match_pattern(int);
+// early decision of pattern being collected
+void _decide_early(af_window &);
+// removes window w of patterns being collected
+void _end_window(int);
+
+// moves column state to/from working variables
+void _channel_load(int);
+void _channel_store(int);
+// processes current measurement of column by scalar code
+int _process_column(int);
+// amends baseline (_diffavg) of current column by _diff
+void _amend_baseline();
+
+// column info for messages (empty for single column input)
+std::string _column_text();
+
+// signal handler ending follow mode
+void _follow_signal(int);
+
+// opens asynchronous reader of input (-U)
+int _open_async_input();
+int _open_stdin();
+int _open_compressed(const char *, size_t, int);
+
+// offset in text input file to start reading at (--from)
+size_t _seek_input();
+
+// block mode processing of all input records, returns non zero on fatal error
+int _run_blocks();
+
+// checkpoint of detector state: written if due (or always), restored
+int _checkpoint(bool);
+int _restore();
+void _checkpoint_state(af_ckpt &);
+void _checkpoint_column(af_ckpt &);
+
+// lifting compared with the convolution on fingerprint files (--check-lifting)
+int _check_lifting_bank();
+
+// lead-in record (before --from) warms up detector noise level
+void _warm_up();
+void _warm_sample();
+void _close_input();
+
 // distance function
 double _eucl_dist(double *, double *, int, int, int, int);
 
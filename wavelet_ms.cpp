@@ -8,6 +8,7 @@
 using namespace std;
 
 # include "wavelet_ms.hpp"
+# include "af_daub.hpp"
 
 //****************************************************************************80
 
@@ -346,7 +347,18 @@ double daub2_scale(int n, double x)
 }
 //****************************************************************************80
 
-double *daub2_transform(int n, double x[])
+// transform of X to a new vector by caller-owned buffer version F
+static double *daub_transform_new(int n, const double x[],
+		void (*f)(int, const double[], double[], double[])) {
+	double *y = new double[n];
+	double *z = new double[n];
+
+	(*f)(n, x, y, z);
+	delete[] z;
+	return y;
+}
+
+void daub2_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -377,39 +389,21 @@ double *daub2_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB2_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[2] = { 7.071067811865475E-01, 7.071067811865475E-01 };
-	int i;
-	int m;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-
-	z = new double[n];
-	for (i = 0; i < n; i++) {
-		z[i] = 0.0;
-	}
-
-	m = n;
-
-	while (2 <= m) {
-		m = m / 2;
-
-		for (i = 0; i < m; i++) {
-			z[i] = c[0] * (y[2 * i] + y[2 * i + 1]);
-			z[i + m] = c[1] * (y[2 * i] - y[2 * i + 1]);
-		}
+	af_daub_transform<2>(n, x, y, z);
+}
+//****************************************************************************80
 
-		for (i = 0; i < 2 * m; i++) {
-			y[i] = z[i];
-		}
-	}
-	delete[] z;
+double *daub2_transform(int n, double x[])
 
-	return y;
+//    DAUB2_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub2_transform);
 }
 //****************************************************************************80
 
@@ -599,7 +593,7 @@ double daub4_scale(int n, double x)
 }
 //****************************************************************************80
 
-double *daub4_transform(int n, double x[])
+void daub4_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -626,55 +620,21 @@ double *daub4_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB4_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[4] = { 0.4829629131445341, 0.8365163037378079, 0.2241438680420133,
-			-0.1294095225512603 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int j2;
-	int j3;
-	int m;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-	for (i = 0; i < n; i++) {
-		z[i] = 0.0;
-	}
-	m = n;
-
-	while (4 <= m) {
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			j0 = i4_wrap(j, 0, m - 1);
-			j1 = i4_wrap(j + 1, 0, m - 1);
-			j2 = i4_wrap(j + 2, 0, m - 1);
-			j3 = i4_wrap(j + 3, 0, m - 1);
-
-			z[i] = c[0] * y[j0] + c[1] * y[j1] + c[2] * y[j2] + c[3] * y[j3];
-
-			z[i + m / 2] = c[3] * y[j0] - c[2] * y[j1] + c[1] * y[j2]
-					- c[0] * y[j3];
-
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<4>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub4_transform(int n, double x[])
 
-	return y;
+//    DAUB4_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub4_transform);
 }
 //****************************************************************************80
 
@@ -893,7 +853,7 @@ double daub6_scale(int n, double x)
 }
 //****************************************************************************80
 
-double *daub6_transform(int n, double x[])
+void daub6_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -920,55 +880,21 @@ double *daub6_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB6_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[6] = { 0.3326705529500826, 0.8068915093110925, 0.4598775021184915,
-			-0.1350110200102545, -0.08544127388202666, 0.03522629188570953 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 5;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-		m = m / 2;
-	}
+	af_daub_transform<6>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub6_transform(int n, double x[])
 
-	return y;
+//    DAUB6_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub6_transform);
 }
 //****************************************************************************80
 
@@ -1196,7 +1122,7 @@ double daub8_scale(int n, double x)
 }
 //****************************************************************************80
 
-double *daub8_transform(int n, double x[])
+void daub8_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -1223,56 +1149,21 @@ double *daub8_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB8_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[8] = { 0.2303778133088964, 0.7148465705529154, 0.6308807679298587,
-			-0.02798376941685985, -0.1870348117190931, 0.03084138183556076,
-			0.03288301166688519, -0.01059740178506903 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 7;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-		m = m / 2;
-	}
+	af_daub_transform<8>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub8_transform(int n, double x[])
 
-	return y;
+//    DAUB8_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub8_transform);
 }
 //****************************************************************************80
 
@@ -1512,7 +1403,7 @@ double daub10_scale(int n, double x)
 }
 //****************************************************************************80
 
-double *daub10_transform(int n, double x[])
+void daub10_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -1539,58 +1430,21 @@ double *daub10_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB10_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[10] = { 1.601023979741929E-01, 6.038292697971896E-01,
-			7.243085284377729E-01, 1.384281459013207E-01,
-			-2.422948870663820E-01, -3.224486958463837E-02,
-			7.757149384004571E-02, -6.241490212798274E-03,
-			-1.258075199908199E-02, 3.335725285473771E-03 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 9;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<10>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub10_transform(int n, double x[])
 
-	return y;
+//    DAUB10_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub10_transform);
 }
 //****************************************************************************80
 
@@ -1782,7 +1636,7 @@ double *daub12_matrix(int n)
 }
 //****************************************************************************80
 
-double *daub12_transform(int n, double x[])
+void daub12_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -1809,59 +1663,21 @@ double *daub12_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB12_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[12] = { 0.1115407433501095E+00, 0.4946238903984533E+00,
-			0.7511339080210959E+00, 0.3152503517091982E+00,
-			-0.2262646939654400E+00, -0.1297668675672625E+00,
-			0.0975016055873225E+00, 0.0275228655303053E+00,
-			-0.0315820393174862E+00, 0.0005538422011614E+00,
-			0.0047772575109455E+00, -0.0010773010853085E+00 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 11;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<12>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub12_transform(int n, double x[])
 
-	return y;
+//    DAUB12_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub12_transform);
 }
 //****************************************************************************80
 
@@ -1947,7 +1763,7 @@ double *daub12_transform_inverse(int n, double y[])
 }
 //****************************************************************************80
 
-double *daub14_transform(int n, double x[])
+void daub14_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -1974,60 +1790,21 @@ double *daub14_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB14_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[14] = { 7.785205408500917E-02, 3.965393194819173E-01,
-			7.291320908462351E-01, 4.697822874051931E-01,
-			-1.439060039285649E-01, -2.240361849938749E-01,
-			7.130921926683026E-02, 8.061260915108307E-02,
-			-3.802993693501441E-02, -1.657454163066688E-02,
-			1.255099855609984E-02, 4.295779729213665E-04,
-			-1.801640704047490E-03, 3.537137999745202E-04 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 13;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<14>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub14_transform(int n, double x[])
 
-	return y;
+//    DAUB14_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub14_transform);
 }
 //****************************************************************************80
 
@@ -2114,7 +1891,7 @@ double *daub14_transform_inverse(int n, double y[])
 }
 //****************************************************************************80
 
-double *daub16_transform(int n, double x[])
+void daub16_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -2141,61 +1918,21 @@ double *daub16_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB16_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[16] = { 5.441584224310400E-02, 3.128715909142999E-01,
-			6.756307362972898E-01, 5.853546836542067E-01,
-			-1.582910525634930E-02, -2.840155429615469E-01,
-			4.724845739132827E-04, 1.287474266204784E-01,
-			-1.736930100180754E-02, -4.408825393079475E-02,
-			1.398102791739828E-02, 8.746094047405776E-03,
-			-4.870352993451574E-03, -3.917403733769470E-04,
-			6.754494064505693E-04, -1.174767841247695E-04 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 15;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<16>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub16_transform(int n, double x[])
 
-	return y;
+//    DAUB16_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub16_transform);
 }
 //****************************************************************************80
 
@@ -2283,7 +2020,7 @@ double *daub16_transform_inverse(int n, double y[])
 }
 //****************************************************************************80
 
-double *daub18_transform(int n, double x[])
+void daub18_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -2310,63 +2047,21 @@ double *daub18_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB18_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[18] =
-			{ 3.807794736387834E-02, 2.438346746125903E-01,
-					6.048231236901111E-01, 6.572880780513005E-01,
-					1.331973858250075E-01, -2.932737832791749E-01,
-					-9.684078322297646E-02, 1.485407493381063E-01,
-					3.072568147933337E-02, -6.763282906132997E-02,
-					2.509471148314519E-04, 2.236166212367909E-02,
-					-4.723204757751397E-03, -4.281503682463429E-03,
-					1.847646883056226E-03, 2.303857635231959E-04,
-					-2.519631889427101E-04, 3.934732031627159E-05 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 17;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<18>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub18_transform(int n, double x[])
 
-	return y;
+//    DAUB18_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub18_transform);
 }
 //****************************************************************************80
 
@@ -2456,7 +2151,7 @@ double *daub18_transform_inverse(int n, double y[])
 }
 //****************************************************************************80
 
-double *daub20_transform(int n, double x[])
+void daub20_transform(int n, const double x[], double y[], double z[])
 
 //****************************************************************************80
 //
@@ -2483,63 +2178,21 @@ double *daub20_transform(int n, double x[])
 //
 //    Input, double X[N], the vector to be transformed. 
 //
-//    Output, double DAUB20_TRANSFORM[N], the transformed vector.
+//    Output, double Y[N], the transformed vector (may be X).
+//
+//    Workspace, double Z[N].
 //
 		{
-	double c[20] = { 2.667005790055555E-02, 1.881768000776914E-01,
-			5.272011889317255E-01, 6.884590394536035E-01, 2.811723436605774E-01,
-			-2.498464243273153E-01, -1.959462743773770E-01,
-			1.273693403357932E-01, 9.305736460357235E-02,
-			-7.139414716639708E-02, -2.945753682187581E-02,
-			3.321267405934100E-02, 3.606553566956169E-03,
-			-1.073317548333057E-02, 1.395351747052901E-03,
-			1.992405295185056E-03, -6.858566949597116E-04,
-			-1.164668551292854E-04, 9.358867032006959E-05,
-			-1.326420289452124E-05 };
-	int i;
-	int j;
-	int j0;
-	int j1;
-	int k;
-	int m;
-	int p = 19;
-	int q;
-	double *y;
-	double *z;
-
-	y = r8vec_copy_new(n, x);
-	z = new double[n];
-
-	m = n;
-	q = (p - 1) / 2;
-
-	while (4 <= m) {
-		for (i = 0; i < m; i++) {
-			z[i] = 0.0;
-		}
-		i = 0;
-
-		for (j = 0; j < m - 1; j = j + 2) {
-			for (k = 0; k < p; k = k + 2) {
-				j0 = i4_wrap(j + k, 0, m - 1);
-				j1 = i4_wrap(j + k + 1, 0, m - 1);
-				z[i] = z[i] + c[k] * y[j0] + c[k + 1] * y[j1];
-				z[i + m / 2] = z[i + m / 2] + c[p - k] * y[j0]
-						- c[p - k - 1] * y[j1];
-			}
-			i = i + 1;
-		}
-
-		for (i = 0; i < m; i++) {
-			y[i] = z[i];
-		}
-
-		m = m / 2;
-	}
+	af_daub_transform<20>(n, x, y, z);
+}
+//****************************************************************************80
 
-	delete[] z;
+double *daub20_transform(int n, double x[])
 
-	return y;
+//    DAUB20_TRANSFORM of X to a new vector (allocated by new[]).
+//
+		{
+	return daub_transform_new(n, x, &daub20_transform);
 }
 //****************************************************************************80
 
@@ -2629,6 +2282,26 @@ double *daub20_transform_inverse(int n, double y[])
 }
 //****************************************************************************80
 
+const double *daub_transform_coefficients(int n)
+
+//****************************************************************************80
+//
+//  Purpose:
+//
+//    DAUB_TRANSFORM_COEFFICIENTS returns the coefficients used by DAUBn_TRANSFORM.
+//
+//  Parameters:
+//
+//    Input, int N, the number of coefficients (2, 4, ..., 20).
+//
+//    Output, const double *DAUB_TRANSFORM_COEFFICIENTS[N], the coefficients,
+//    NULL for other N.
+//
+		{
+	return af_daub_coefficients(n);
+}
+//****************************************************************************80
+
 bool i4_is_power_of_2(int n)
 
 //****************************************************************************80
@@ -6,36 +6,47 @@ class X {
 
 double *cascade(int n, int t_length, double t[], int c_length, double c[]);
 double *daub_coefficients(int n);
+const double *daub_transform_coefficients(int n);
 double *daub2_matrix(int n);
 double daub2_scale(int n, double x);
 double *daub2_transform(int n, double x[]);
+void daub2_transform(int n, const double x[], double y[], double z[]);
 double *daub2_transform_inverse(int n, double y[]);
 double *daub4_matrix(int n);
 double daub4_scale(int n, double x);
 double *daub4_transform(int n, double x[]);
+void daub4_transform(int n, const double x[], double y[], double z[]);
 double *daub4_transform_inverse(int n, double y[]);
 double *daub6_matrix(int n);
 double daub6_scale(int n, double x);
 double *daub6_transform(int n, double x[]);
+void daub6_transform(int n, const double x[], double y[], double z[]);
 double *daub6_transform_inverse(int n, double y[]);
 double *daub8_matrix(int n);
 double daub8_scale(int n, double x);
 double *daub8_transform(int n, double x[]);
+void daub8_transform(int n, const double x[], double y[], double z[]);
 double *daub8_transform_inverse(int n, double y[]);
 double *daub10_matrix(int n);
 double daub10_scale(int n, double x);
 double *daub10_transform(int n, double x[]);
+void daub10_transform(int n, const double x[], double y[], double z[]);
 double *daub10_transform_inverse(int n, double y[]);
 double *daub12_matrix(int n);
 double *daub12_transform(int n, double x[]);
+void daub12_transform(int n, const double x[], double y[], double z[]);
 double *daub12_transform_inverse(int n, double y[]);
 double *daub14_transform(int n, double x[]);
+void daub14_transform(int n, const double x[], double y[], double z[]);
 double *daub14_transform_inverse(int n, double y[]);
 double *daub16_transform(int n, double x[]);
+void daub16_transform(int n, const double x[], double y[], double z[]);
 double *daub16_transform_inverse(int n, double y[]);
 double *daub18_transform(int n, double x[]);
+void daub18_transform(int n, const double x[], double y[], double z[]);
 double *daub18_transform_inverse(int n, double y[]);
 double *daub20_transform(int n, double x[]);
+void daub20_transform(int n, const double x[], double y[], double z[]);
 double *daub20_transform_inverse(int n, double y[]);
 bool i4_is_power_of_2(int n);
 inline int i4_max(int i1, int i2);